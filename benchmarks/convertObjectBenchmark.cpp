@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <QUuid>
+#include "../model/scene.h"
+#include "../model/projection.h"
+#include "../model/simdKernels.h"
+
+/*
+ * Compares the staged reference conversion with the fused pipeline, in
+ * double and in single precision, on random shapes of 4..12 dimensions
+ * projected to 3-D. The last speedup is single over double.
+ *
+ * The second table times one step of a rotator drag: the last angle
+ * changes and the object is converted again, in full or from the rotated
+ * coordinates kept by SceneObject::rotatedCoords().
+ *
+ * The third table times that delta path's two column kernels alone,
+ * scalar against the vector tier: rotating the plane's two columns and
+ * the diagonal conversion of all columns to 3-D.
+ *
+ * Build with -DBUILD_BENCHMARKS=ON and a Release configuration.
+ */
+
+namespace {
+SceneObject makeObject(std::size_t dim, std::size_t vertexCount, std::mt19937& rng)
+{
+    std::uniform_real_distribution<double> coord(-0.5, 0.5);
+    auto shape = std::make_shared<NDShape>(dim);
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        std::vector<double> p(dim);
+        for (double& c : p) c = coord(rng);
+        shape->addVertex(p);
+    }
+
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.shape      = shape;
+    obj.projection = std::make_shared<PerspectiveProjection>(3.0);
+    for (std::size_t a = 0; a + 1 < dim; ++a)
+        obj.rotators.push_back(Rotator(a, a + 1, 0.1 * double(a + 1)));
+    obj.scale  = { 1.0, 1.0, 1.0 };
+    obj.offset = { 0.0, 0.0, 0.0 };
+    return obj;
+}
+
+template<typename F>
+double bestOfMs(int repeats, F&& f)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+} // namespace
+
+int main()
+{
+    constexpr std::size_t kVertexCount = 20000;
+    constexpr int         kRepeats     = 10;
+    std::mt19937 rng(42);
+
+    std::printf("kernels: %s\n", simdLevelName(detectSimdLevel()));
+    ConversionOptions single;
+    single.precision = ConversionPrecision::Single;
+
+    std::printf("%4s %12s %12s %8s %12s %8s\n", "dim", "staged, ms", "fused, ms", "speedup",
+                "single, ms", "speedup");
+    for (std::size_t dim = 4; dim <= 12; ++dim) {
+        SceneObject obj = makeObject(dim, kVertexCount, rng);
+        volatile double sink = 0.0;   // keeps the conversions from being optimised away
+        double staged = bestOfMs(kRepeats, [&] { sink += Scene::convertObjectStaged(obj, 3).coords[0]; });
+        double fused  = bestOfMs(kRepeats, [&] { sink += Scene::convertObject(obj, 3).coords[0]; });
+        double f32    = bestOfMs(kRepeats, [&] {
+            sink += Scene::convertObject(obj, 3, single).coordsSingle[0];
+        });
+        std::printf("%4zu %12.3f %12.3f %7.2fx %12.3f %7.2fx\n", dim, staged, fused,
+                    staged / fused, f32, fused / f32);
+    }
+
+    ConversionOptions full;
+    full.incrementalRotation = false;
+
+    std::printf("\n%4s %12s %12s %8s\n", "dim", "full, ms", "delta, ms", "speedup");
+    for (std::size_t dim = 4; dim <= 12; ++dim) {
+        SceneObject obj = makeObject(dim, kVertexCount, rng);
+        volatile double sink = 0.0;
+        auto drag = [&](const ConversionOptions& options) {
+            return bestOfMs(kRepeats, [&] {
+                Rotator& last = obj.rotators.back();
+                last.setAngle(last.angle() + 0.01);
+                sink += Scene::convertObject(obj, 3, options).coords[0];
+            });
+        };
+        double whole = drag(full);
+        double delta = drag(ConversionOptions{});
+        std::printf("%4zu %12.3f %12.3f %7.2fx\n", dim, whole, delta, whole / delta);
+    }
+
+    std::printf("\n%4s %14s %14s %8s %14s %14s %8s\n", "dim", "rotate, us", "vector, us",
+                "speedup", "diagonal, us", "vector, us", "speedup");
+    for (std::size_t dim = 4; dim <= 12; ++dim) {
+        std::uniform_real_distribution<double> coord(-0.5, 0.5);
+        std::vector<std::vector<double>> columns(dim, std::vector<double>(kVertexCount));
+        std::vector<const double*> columnPtrs;
+        for (auto& c : columns) {
+            for (double& x : c) x = coord(rng);
+            columnPtrs.push_back(c.data());
+        }
+        const HomogeneousTransform t = composeHomogeneous(
+            dim, 3, nullptr, PerspectiveParams{ 3.0 }, nullptr, nullptr);
+        std::vector<double> x(kVertexCount), y(kVertexCount), out(kVertexCount * 3);
+        std::vector<unsigned char> valid(kVertexCount);
+
+        const KernelTable& scalar = kernelsFor(dim, SimdLevel::Scalar);
+        const KernelTable& vector = kernelsFor(dim);
+        auto rotate = [&](const KernelTable& k) {
+            return bestOfMs(kRepeats, [&] {
+                k.rotateColumns(columnPtrs[0], columnPtrs[dim - 1], x.data(), y.data(),
+                                kVertexCount, std::cos(0.01), std::sin(0.01));
+            }) * 1000.0;
+        };
+        auto diagonal = [&](const KernelTable& k) {
+            return bestOfMs(kRepeats, [&] {
+                k.convertDiagonal(columnPtrs.data(), out.data(), kVertexCount, dim, 3,
+                                  t.matrix.data(), nullptr, t.divide, valid.data());
+            }) * 1000.0;
+        };
+        const double rs = rotate(scalar), rv = rotate(vector);
+        const double ds = diagonal(scalar), dv = diagonal(vector);
+        std::printf("%4zu %14.1f %14.1f %7.2fx %14.1f %14.1f %7.2fx\n", dim, rs, rv, rs / rv,
+                    ds, dv, ds / dv);
+    }
+    return 0;
+}
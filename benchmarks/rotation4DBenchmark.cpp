@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../model/isoclinicRotation.h"
+
+/*
+ * Composes 4-D chains of plane rotations two ways and reports how far the
+ * result drifts from orthonormal:
+ *   givens     - Rotator::composeChain(), one Givens matrix product per rotator
+ *   quaternion - IsoclinicPair::fromChain(), expanded with toMatrix()
+ *
+ * Both hand the same 4×4 matrix to the conversion kernels, so the per-vertex
+ * cost is identical and not measured here; the fold only buys stability.
+ * The compose times are listed to show what that stability costs.
+ *
+ * Build with -DBUILD_BENCHMARKS=ON and a Release configuration.
+ */
+
+namespace {
+template<typename F>
+double bestOfUs(int repeats, F&& f)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+/// Largest entry of |MᵀM − I| for a row-major 4×4 matrix.
+double orthonormalityError(const std::vector<double>& m)
+{
+    double worst = 0.0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            double dot = 0.0;
+            for (std::size_t k = 0; k < 4; ++k)
+                dot += m[k * 4 + i] * m[k * 4 + j];
+            worst = std::max(worst, std::fabs(dot - (i == j ? 1.0 : 0.0)));
+        }
+    }
+    return worst;
+}
+} // namespace
+
+int main()
+{
+    constexpr int kRepeats = 5;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> angle(-3.0, 3.0);
+    std::uniform_int_distribution<std::size_t> axis(0, 3);
+
+    std::printf("%8s %14s %16s %12s %16s\n", "chain", "givens drift", "quaternion drift",
+                "givens, us", "quaternion, us");
+    for (std::size_t length : { 10U, 100U, 1000U, 10000U, 100000U }) {
+        std::vector<Rotator> chain;
+        while (chain.size() < length) {
+            std::size_t a = axis(rng), b = axis(rng);
+            if (a != b) chain.push_back(Rotator(a, b, angle(rng)));
+        }
+
+        std::vector<double> givens, quaternion;
+        double givensUs = bestOfUs(kRepeats, [&] {
+            givens = Rotator::composeChain(chain, 4);
+        });
+        double quaternionUs = bestOfUs(kRepeats, [&] {
+            quaternion = IsoclinicPair::fromChain(chain).toMatrix();
+        });
+        std::printf("%8zu %14.3e %16.3e %12.1f %16.1f\n", length, orthonormalityError(givens),
+                    orthonormalityError(quaternion), givensUs, quaternionUs);
+    }
+    return 0;
+}
@@ -193,6 +193,12 @@ int main(int argc, char *argv[])
         QString clearColorStr       = readOrDefault("sceneRendererClearColor", "#8f8f8f");
         QString overlayPenColorStr  = readOrDefault("sceneOverlayNumberPenColor", "#000000");
 
+        QJsonValue compactIdsValue = configManager.getValue("compactVertexIdsOnSave");
+        if (!compactIdsValue.isBool()) {
+            compactIdsValue = false;
+            configManager.setValue("compactVertexIdsOnSave", compactIdsValue);
+        }
+
         QString tmpConfig = configPath + ".tmp";
         if (configManager.saveConfig(tmpConfig) && QFile::rename(tmpConfig, configPath)) {
             qDebug() << "Config saved to" << configPath;
@@ -203,6 +209,7 @@ int main(int argc, char *argv[])
         SceneColorificator::defaultColor = QColor(sceneObjColorStr);
         SceneRenderer::clearSceneColor = QColor(clearColorStr);
         SceneGeometryManager::sceneOverlayNumberPen = QPen(QColor(overlayPenColorStr));
+        PresenterMainTab::compactIdsOnSave = compactIdsValue.toBool();
 
         qDebug() << "defaultColor ="
                  << SceneColorificator::defaultColor.name(QColor::HexArgb);
@@ -210,6 +217,7 @@ int main(int argc, char *argv[])
                  << SceneRenderer::clearSceneColor.name(QColor::HexArgb);
         qDebug() << "overlayNumberPenColor ="
                  << SceneGeometryManager::sceneOverlayNumberPen.color().name(QColor::HexArgb);
+        qDebug() << "compactVertexIdsOnSave =" << PresenterMainTab::compactIdsOnSave;
     }
 
     MainWindow mainWindow = MainWindow();
@@ -1,6 +1,10 @@
 #include "NDShape.h"
 #include <QDebug>
 #include <algorithm>
+#include <functional>
+
+const NDShape::VertexStore   NDShape::emptyVerts_{};
+const NDShape::TopologyStore NDShape::emptyTopo_{};
 
 NDShape::NDShape(std::size_t dimension)
     : dimension_(dimension), vertexCounter_(0)
@@ -22,14 +26,29 @@ std::size_t NDShape::addVertex(const std::vector<double>& coords) {
         qWarning() << msg;
         throw std::invalid_argument(msg.toStdString());
     }
+    VertexStore& v = mutableVerts();
     std::size_t id = vertexCounter_++;
-    vertices_[id] = coords;
+    v.idToSlot.push_back(v.slotIds.size());
+    v.slotIds.push_back(id);
+    v.coords.insert(v.coords.end(), coords.begin(), coords.end());
     return id;
 }
 
+std::size_t NDShape::addVertices(const double* flat, std::size_t count) {
+    VertexStore& v = mutableVerts();
+    const std::size_t first = vertexCounter_;
+    v.idToSlot.reserve(v.idToSlot.size() + count);
+    v.slotIds.reserve(v.slotIds.size() + count);
+    for (std::size_t k = 0; k < count; ++k) {
+        v.idToSlot.push_back(v.slotIds.size());
+        v.slotIds.push_back(vertexCounter_++);
+    }
+    v.coords.insert(v.coords.end(), flat, flat + count * dimension_);
+    return first;
+}
+
 void NDShape::addEdge(std::size_t id1, std::size_t id2) {
-    if (vertices_.find(id1) == vertices_.end() ||
-        vertices_.find(id2) == vertices_.end()) {
+    if (slotOf(id1) == npos || slotOf(id2) == npos) {
         QString msg = "One or both vertex IDs do not exist.";
         qWarning() << msg;
         throw std::out_of_range(msg.toStdString());
@@ -41,31 +60,41 @@ void NDShape::addEdge(std::size_t id1, std::size_t id2) {
         throw std::invalid_argument(msg.toStdString());
     }
 
-    auto it = std::find_if(edges_.begin(), edges_.end(),
-                           [id1, id2](const std::pair<std::size_t, std::size_t>& edge) {
-                               return (edge.first == id1 && edge.second == id2) ||
-                                      (edge.first == id2 && edge.second == id1);
-                           });
-    if (it != edges_.end()) {
+    if (hasEdge(id1, id2)) {
         QString msg = "Edge already exists.";
         qWarning() << msg;
         throw std::invalid_argument(msg.toStdString());
     }
 
-    edges_.emplace_back(id1, id2);
+    TopologyStore& t = mutableTopo();
+    t.edgeIndex.emplace(edgeKey(id1, id2), t.edges.size());
+    t.edges.emplace_back(id1, id2);
+    if (t.incidence.size() < vertexCounter_)
+        t.incidence.resize(vertexCounter_);
+    t.incidence[id1].push_back(id2);
+    t.incidence[id2].push_back(id1);
+}
+
+bool NDShape::hasEdge(std::size_t id1, std::size_t id2) const {
+    if (id1 == id2) return false;
+    const auto& index = topo().edgeIndex;
+    return index.find(edgeKey(id1, id2)) != index.end();
 }
 
 std::vector<std::pair<std::size_t, std::vector<double>>> NDShape::getAllVertices() const {
+    const VertexStore& v = verts();
     std::vector<std::pair<std::size_t, std::vector<double>>> result;
-    result.reserve(vertices_.size());
-    for (const auto& [id, coords] : vertices_) {
-        result.emplace_back(id, coords);
+    result.reserve(v.slotIds.size());
+    for (std::size_t slot = 0; slot < v.slotIds.size(); ++slot) {
+        auto first = v.coords.begin() + slot * dimension_;
+        result.emplace_back(v.slotIds[slot], std::vector<double>(first, first + dimension_));
     }
     return result;
 }
 
 void NDShape::setVertexCoords(std::size_t vertexId, const std::vector<double>& newCoords) {
-    if (vertices_.find(vertexId) == vertices_.end()) {
+    std::size_t slot = slotOf(vertexId);
+    if (slot == npos) {
         QString msg = "Vertex ID does not exist.";
         qWarning() << msg;
         throw std::out_of_range(msg.toStdString());
@@ -75,11 +104,11 @@ void NDShape::setVertexCoords(std::size_t vertexId, const std::vector<double>& n
         qWarning() << msg;
         throw std::invalid_argument(msg.toStdString());
     }
-    vertices_[vertexId] = newCoords;
+    std::copy(newCoords.begin(), newCoords.end(), mutableVerts().coords.begin() + slot * dimension_);
 }
 
 const std::vector<std::pair<std::size_t, std::size_t>>& NDShape::getEdges() const {
-    return edges_;
+    return topo().edges;
 }
 
 NDShape NDShape::clone(std::size_t newDim) const {
@@ -89,26 +118,27 @@ NDShape NDShape::clone(std::size_t newDim) const {
         throw std::invalid_argument(msg.toStdString());
     }
 
+    if (newDim == dimension_)
+        return *this;
+
     NDShape cloned(newDim);
-    // copy over edges and counter
-    cloned.edges_ = edges_;
+    // share the topology, copy the ID index and counter
+    cloned.topo_ = topo_;
     cloned.vertexCounter_ = vertexCounter_;
 
-    // adjust each vertex's coords to the new dimension
-    for (const auto& [id, oldCoords] : vertices_) {
-        std::vector<double> newCoords;
-        newCoords.reserve(newDim);
-
-        // copy as many old coords as will fit
-        std::size_t copyCount = std::min(oldCoords.size(), newDim);
-        for (std::size_t i = 0; i < copyCount; ++i)
-            newCoords.push_back(oldCoords[i]);
-
-        // zero-fill any extra dimensions
-        for (std::size_t i = copyCount; i < newDim; ++i)
-            newCoords.push_back(0.0);
-
-        cloned.vertices_[id] = std::move(newCoords);
+    const VertexStore& src = verts();
+    VertexStore& dst = cloned.mutableVerts();
+    dst.slotIds = src.slotIds;
+    dst.idToSlot = src.idToSlot;
+
+    // restride the coordinate buffer: copy as many old coords as will fit,
+    // extra dimensions stay zero-filled
+    const std::size_t count = src.slotIds.size();
+    const std::size_t copyCount = std::min(dimension_, newDim);
+    dst.coords.assign(count * newDim, 0.0);
+    for (std::size_t slot = 0; slot < count; ++slot) {
+        const double* row = src.coords.data() + slot * dimension_;
+        std::copy(row, row + copyCount, dst.coords.begin() + slot * newDim);
     }
 
     return cloned;
@@ -116,46 +146,168 @@ NDShape NDShape::clone(std::size_t newDim) const {
 
 
 void NDShape::removeVertex(std::size_t vertexId) {
-    auto it = vertices_.find(vertexId);
-    if (it == vertices_.end()) {
+    std::size_t slot = slotOf(vertexId);
+    if (slot == npos) {
         QString msg = "Vertex ID does not exist.";
         qWarning() << msg;
         throw std::out_of_range(msg.toStdString());
     }
-    vertices_.erase(it);
 
-    auto newEnd = std::remove_if(edges_.begin(), edges_.end(),
-                                 [vertexId](const std::pair<std::size_t, std::size_t>& edge) {
-                                     return edge.first == vertexId || edge.second == vertexId;
-                                 });
-    edges_.erase(newEnd, edges_.end());
+    // move the last slot into the gap; the next read sorts the slots again
+    VertexStore& v = mutableVerts();
+    const std::size_t last = v.slotIds.size() - 1;
+    if (slot != last) {
+        std::copy_n(v.coords.begin() + last * dimension_, dimension_,
+                    v.coords.begin() + slot * dimension_);
+        v.slotIds[slot] = v.slotIds[last];
+        v.idToSlot[v.slotIds[slot]] = slot;
+        v.unordered.store(true, std::memory_order_relaxed);
+    }
+    v.coords.resize(last * dimension_);
+    v.slotIds.pop_back();
+    v.idToSlot[vertexId] = npos;
+
+    // drop only the incident edges
+    const auto& incidence = topo().incidence;
+    if (vertexId >= incidence.size() || incidence[vertexId].empty())
+        return;
+    TopologyStore& t = mutableTopo();
+    std::vector<std::size_t> neighbours = std::move(t.incidence[vertexId]);
+    t.incidence[vertexId].clear();
+    for (std::size_t n : neighbours) {
+        auto it = t.edgeIndex.find(edgeKey(vertexId, n));
+        eraseEdgeAt(it->second);
+    }
 }
 
 void NDShape::removeEdge(std::size_t id1, std::size_t id2) {
-    bool found = false;
-    auto newEnd = std::remove_if(edges_.begin(), edges_.end(),
-                                 [id1, id2, &found](const std::pair<std::size_t, std::size_t>& edge) {
-                                     if ((edge.first == id1 && edge.second == id2) ||
-                                         (edge.first == id2 && edge.second == id1)) {
-                                         found = true;
-                                         return true;
-                                     }
-                                     return false;
-                                 });
-    if (!found) {
+    const auto& index = topo().edgeIndex;
+    auto it = (id1 == id2) ? index.end() : index.find(edgeKey(id1, id2));
+    if (it == index.end()) {
         QString msg = "Edge between given vertices does not exist.";
         qWarning() << msg;
         throw std::out_of_range(msg.toStdString());
     }
-    edges_.erase(newEnd, edges_.end());
+    const std::size_t pos = it->second;
+    mutableTopo();
+    eraseEdgeAt(pos);
 }
 
-std::vector<std::vector<int>> NDShape::getAdjacencyMatrix() const {
-    std::vector<std::size_t> vertexIds;
-    for (const auto& pair : vertices_) {
-        vertexIds.push_back(pair.first);
+void NDShape::removeVertices(const std::vector<std::size_t>& vertexIds) {
+    // validate everything up front so a bad ID leaves the shape untouched
+    std::vector<bool> removedSlots(verts().slotIds.size(), false);
+    for (std::size_t id : vertexIds) {
+        std::size_t slot = slotOf(id);
+        if (slot == npos) {
+            QString msg = "Vertex ID does not exist.";
+            qWarning() << msg;
+            throw std::out_of_range(msg.toStdString());
+        }
+        removedSlots[slot] = true;
+    }
+
+    // mark incident edges before the slots move
+    const auto& edges = topo().edges;
+    const auto& idToSlot = verts().idToSlot;
+    std::vector<bool> removedEdges(edges.size(), false);
+    for (std::size_t e = 0; e < edges.size(); ++e)
+        removedEdges[e] = removedSlots[idToSlot[edges[e].first]]
+                       || removedSlots[idToSlot[edges[e].second]];
+
+    // compact vertex rows in place
+    VertexStore& v = mutableVerts();
+    std::size_t write = 0;
+    for (std::size_t slot = 0; slot < v.slotIds.size(); ++slot) {
+        const std::size_t id = v.slotIds[slot];
+        if (removedSlots[slot]) {
+            v.idToSlot[id] = npos;
+            continue;
+        }
+        if (write != slot) {
+            std::copy_n(v.coords.begin() + slot * dimension_, dimension_,
+                        v.coords.begin() + write * dimension_);
+            v.slotIds[write] = id;
+        }
+        v.idToSlot[id] = write++;
     }
-    std::sort(vertexIds.begin(), vertexIds.end());
+    v.coords.resize(write * dimension_);
+    v.slotIds.resize(write);
+
+    compactEdges(removedEdges);
+}
+
+void NDShape::removeEdges(const std::vector<std::pair<std::size_t, std::size_t>>& edges) {
+    const TopologyStore& t = topo();
+    std::vector<bool> removedEdges(t.edges.size(), false);
+    for (const auto& [id1, id2] : edges) {
+        auto it = (id1 == id2) ? t.edgeIndex.end() : t.edgeIndex.find(edgeKey(id1, id2));
+        if (it == t.edgeIndex.end()) {
+            QString msg = "Edge between given vertices does not exist.";
+            qWarning() << msg;
+            throw std::out_of_range(msg.toStdString());
+        }
+        removedEdges[it->second] = true;
+    }
+    compactEdges(removedEdges);
+}
+
+void NDShape::compactEdges(const std::vector<bool>& removedEdges) {
+    if (std::find(removedEdges.begin(), removedEdges.end(), true) == removedEdges.end())
+        return;
+
+    TopologyStore& t = mutableTopo();
+    std::vector<bool> touched(t.incidence.size(), false);
+    std::size_t write = 0;
+    for (std::size_t e = 0; e < t.edges.size(); ++e) {
+        const Edge edge = t.edges[e];
+        if (removedEdges[e]) {
+            t.edgeIndex.erase(edgeKey(edge.first, edge.second));
+            touched[edge.first]  = true;
+            touched[edge.second] = true;
+            continue;
+        }
+        if (write != e) {
+            t.edges[write] = edge;
+            t.edgeIndex[edgeKey(edge.first, edge.second)] = write;
+        }
+        ++write;
+    }
+    t.edges.resize(write);
+
+    // refill the incidence lists of touched vertices from the kept edges
+    for (std::size_t id = 0; id < t.incidence.size(); ++id)
+        if (touched[id]) t.incidence[id].clear();
+    for (const auto& [a, b] : t.edges) {
+        if (touched[a]) t.incidence[a].push_back(b);
+        if (touched[b]) t.incidence[b].push_back(a);
+    }
+}
+
+void NDShape::eraseEdgeAt(std::size_t pos) {
+    TopologyStore& t = *topo_;
+    const Edge edge = t.edges[pos];
+    t.edgeIndex.erase(edgeKey(edge.first, edge.second));
+
+    if (pos + 1 != t.edges.size()) {
+        t.edges[pos] = t.edges.back();
+        t.edgeIndex[edgeKey(t.edges[pos].first, t.edges[pos].second)] = pos;
+    }
+    t.edges.pop_back();
+
+    auto unlink = [](std::vector<std::size_t>& list, std::size_t id) {
+        auto it = std::find(list.begin(), list.end(), id);
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    };
+    unlink(t.incidence[edge.first], edge.second);
+    unlink(t.incidence[edge.second], edge.first);
+}
+
+std::vector<std::vector<int>> NDShape::getAdjacencyMatrix() const {
+    const std::vector<std::size_t>& vertexIds = verts().slotIds;
+    const AdjacencyBitMatrix bits = getAdjacencyBits();
 
     std::size_t n = vertexIds.size();
     std::vector<std::vector<int>> matrix(n + 1, std::vector<int>(n + 1, 0));
@@ -164,31 +316,45 @@ std::vector<std::vector<int>> NDShape::getAdjacencyMatrix() const {
     for (std::size_t i = 0; i < n; ++i) {
         matrix[0][i + 1] = static_cast<int>(vertexIds[i]);
         matrix[i + 1][0] = static_cast<int>(vertexIds[i]);
+        matrix[i + 1][i + 1] = -1;
     }
 
-    for (std::size_t i = 0; i < n; ++i) {
-        for (std::size_t j = 0; j < n; ++j) {
-            if (i == j) {
-                matrix[i + 1][j + 1] = -1;
-            } else {
-                bool edgeFound = false;
-                for (const auto& edge : edges_) {
-                    if ((edge.first == vertexIds[i] && edge.second == vertexIds[j]) ||
-                        (edge.first == vertexIds[j] && edge.second == vertexIds[i])) {
-                        edgeFound = true;
-                        break;
-                    }
-                }
-                matrix[i + 1][j + 1] = edgeFound ? 1 : 0;
-            }
-        }
-    }
+    bits.forEachSetPair([&matrix](std::size_t i, std::size_t j) {
+        matrix[i + 1][j + 1] = 1;
+        matrix[j + 1][i + 1] = 1;
+    });
     return matrix;
 }
 
+AdjacencyBitMatrix NDShape::getAdjacencyBits() const {
+    const VertexStore& v = verts();
+    AdjacencyBitMatrix bits(v.slotIds.size());
+    for (const auto& edge : topo().edges)
+        bits.set(v.idToSlot[edge.first], v.idToSlot[edge.second]);
+    return bits;
+}
+
+void NDShape::applyAdjacencyBits(const AdjacencyBitMatrix& target) {
+    if (target.size() != verts().slotIds.size()) {
+        QString msg = "Adjacency matrix size does not match the number of vertices.";
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+
+    AdjacencyBitMatrix diff = getAdjacencyBits();
+    diff ^= target;
+
+    const std::vector<std::size_t>& vertexIds = verts().slotIds;
+    diff.forEachSetPair([&](std::size_t i, std::size_t j) {
+        if (target.test(i, j))
+            addEdge(vertexIds[i], vertexIds[j]);
+        else
+            removeEdge(vertexIds[i], vertexIds[j]);
+    });
+}
 
 void NDShape::updateFromAdjacencyMatrix(const std::vector<std::vector<int>>& matrix) {
-    std::size_t n = vertices_.size();
+    std::size_t n = verts().slotIds.size();
 
     if (matrix.size() != n) {
         QString msg = "Adjacency matrix row count does not match the number of vertices.";
@@ -203,12 +369,8 @@ void NDShape::updateFromAdjacencyMatrix(const std::vector<std::vector<int>>& mat
         }
     }
 
-    std::vector<std::size_t> vertexIds;
-    for (const auto& pair : vertices_) {
-        vertexIds.push_back(pair.first);
-    }
-    std::sort(vertexIds.begin(), vertexIds.end());
-
+    // validate and pack the upper triangle first, so a bad cell leaves the shape untouched
+    AdjacencyBitMatrix target(n);
     for (std::size_t i = 0; i < n; ++i) {
         for (std::size_t j = i + 1; j < n; ++j) {
             int newVal = matrix[i][j];
@@ -218,43 +380,176 @@ void NDShape::updateFromAdjacencyMatrix(const std::vector<std::vector<int>>& mat
                 qWarning() << msg;
                 throw std::invalid_argument(msg.toStdString());
             }
-
-            bool exists = false;
-            for (const auto& edge : edges_) {
-                if ((edge.first == vertexIds[i] && edge.second == vertexIds[j]) ||
-                    (edge.first == vertexIds[j] && edge.second == vertexIds[i])) {
-                    exists = true;
-                    break;
-                }
-            }
-            int currentVal = exists ? 1 : 0;
-
-            if (newVal != currentVal) {
-                if (newVal == 1) {
-                    addEdge(vertexIds[i], vertexIds[j]);
-                } else {
-                    removeEdge(vertexIds[i], vertexIds[j]);
-                }
-            }
+            if (newVal == 1)
+                target.set(i, j);
         }
     }
+
+    applyAdjacencyBits(target);
 }
 
-const std::vector<double>& NDShape::getVertex(std::size_t vertexId) const
+std::vector<double> NDShape::getVertex(std::size_t vertexId) const
 {
-    auto it = vertices_.find(vertexId);
-    if (it == vertices_.end()) {
+    std::size_t slot = slotOf(vertexId);
+    if (slot == npos) {
         throw std::out_of_range("NDShape::getVertex: vertex ID not found");
     }
-    return it->second;
+    auto first = indexedVerts().coords.begin() + slot * dimension_;
+    return std::vector<double>(first, first + dimension_);
+}
+
+CoordSpan NDShape::vertexCoords(std::size_t vertexId) const
+{
+    std::size_t slot = slotOf(vertexId);
+    if (slot == npos) {
+        throw std::out_of_range("NDShape::vertexCoords: vertex ID not found");
+    }
+    return CoordSpan(indexedVerts().coords.data() + slot * dimension_, dimension_);
+}
+
+std::vector<std::size_t> NDShape::compact()
+{
+    const VertexStore&   v = verts();
+    const TopologyStore& t = topo();
+    const std::size_t count = v.slotIds.size();
+
+    // breadth-first order over the edge graph, one component at a time
+    std::vector<std::size_t> remap(vertexCounter_, npos);
+    std::vector<std::size_t> order;
+    order.reserve(count);
+    std::vector<std::size_t> neighbours;
+    for (std::size_t root : v.slotIds) {
+        if (remap[root] != npos) continue;
+        remap[root] = order.size();
+        order.push_back(root);
+        for (std::size_t head = order.size() - 1; head < order.size(); ++head) {
+            const std::size_t id = order[head];
+            if (id >= t.incidence.size()) continue;
+            neighbours = t.incidence[id];
+            std::sort(neighbours.begin(), neighbours.end());
+            for (std::size_t n : neighbours) {
+                if (remap[n] != npos) continue;
+                remap[n] = order.size();
+                order.push_back(n);
+            }
+        }
+    }
+
+    auto newVerts = std::make_shared<VertexStore>();
+    newVerts->coords.resize(count * dimension_);
+    newVerts->slotIds.resize(count);
+    newVerts->idToSlot.resize(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        std::copy_n(v.coords.begin() + v.idToSlot[order[k]] * dimension_, dimension_,
+                    newVerts->coords.begin() + k * dimension_);
+        newVerts->slotIds[k]  = k;
+        newVerts->idToSlot[k] = k;
+    }
+
+    auto newTopo = std::make_shared<TopologyStore>();
+    newTopo->edges.reserve(t.edges.size());
+    for (const auto& [a, b] : t.edges)
+        newTopo->edges.emplace_back(remap[a], remap[b]);
+    std::sort(newTopo->edges.begin(), newTopo->edges.end(),
+              [](const Edge& x, const Edge& y) { return edgeKey(x.first, x.second) < edgeKey(y.first, y.second); });
+    newTopo->edgeIndex.reserve(newTopo->edges.size());
+    newTopo->incidence.resize(count);
+    for (std::size_t e = 0; e < newTopo->edges.size(); ++e) {
+        const auto [a, b] = newTopo->edges[e];
+        newTopo->edgeIndex.emplace(edgeKey(a, b), e);
+        newTopo->incidence[a].push_back(b);
+        newTopo->incidence[b].push_back(a);
+    }
+
+    verts_ = std::move(newVerts);
+    topo_  = std::move(newTopo);
+    vertexCounter_ = count;
+    return remap;
 }
 
 int NDShape::verticesSize() const
 {
-    return vertices_.size();
+    return indexedVerts().slotIds.size();
 }
 
 int NDShape::edgesSize() const
 {
-    return edges_.size();
+    return topo().edges.size();
+}
+
+bool NDShape::sharesDataWith(const NDShape& other) const
+{
+    return dimension_ == other.dimension_ && vertexCounter_ == other.vertexCounter_
+           && verts_ == other.verts_ && topo_ == other.topo_;
+}
+
+std::size_t NDShape::slotOf(std::size_t vertexId) const
+{
+    const auto& idToSlot = indexedVerts().idToSlot;
+    return vertexId < idToSlot.size() ? idToSlot[vertexId] : npos;
+}
+
+NDShape::VertexStore::VertexStore(const VertexStore& other)
+{
+    // another copy of the shape may be sorting the slots right now
+    std::lock_guard<std::mutex> lock(other.orderMutex);
+    coords    = other.coords;
+    slotIds   = other.slotIds;
+    idToSlot  = other.idToSlot;
+    unordered.store(other.unordered.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void NDShape::restoreSlotOrder() const
+{
+    VertexStore& v = *verts_;
+    std::lock_guard<std::mutex> lock(v.orderMutex);
+    if (!v.unordered.load(std::memory_order_relaxed))
+        return;
+
+    // walking the ID index visits the vertices in ascending order
+    std::vector<double> coords(v.coords.size());
+    std::size_t next = 0;
+    for (std::size_t id = 0; id < v.idToSlot.size(); ++id) {
+        const std::size_t slot = v.idToSlot[id];
+        if (slot == npos) continue;
+        std::copy_n(v.coords.begin() + slot * dimension_, dimension_,
+                    coords.begin() + next * dimension_);
+        v.slotIds[next] = id;
+        v.idToSlot[id]  = next++;
+    }
+    v.coords = std::move(coords);
+    v.unordered.store(false, std::memory_order_release);
+}
+
+NDShape::VertexStore& NDShape::mutableVerts()
+{
+    if (!verts_)
+        verts_ = std::make_shared<VertexStore>();
+    else if (verts_.use_count() > 1)
+        verts_ = std::make_shared<VertexStore>(*verts_);
+    return *verts_;
+}
+
+NDShape::TopologyStore& NDShape::mutableTopo()
+{
+    if (!topo_)
+        topo_ = std::make_shared<TopologyStore>();
+    else if (topo_.use_count() > 1)
+        topo_ = std::make_shared<TopologyStore>(*topo_);
+    return *topo_;
+}
+
+NDShape::Edge NDShape::edgeKey(std::size_t id1, std::size_t id2)
+{
+    return id1 < id2 ? Edge(id1, id2) : Edge(id2, id1);
+}
+
+std::size_t NDShape::EdgeHash::operator()(const Edge& e) const noexcept
+{
+    std::size_t seed = std::hash<std::size_t>{}(e.first);
+    seed ^= std::hash<std::size_t>{}(e.second)
+            + 0x9e3779b97f4a7c15ULL
+            + (seed << 6)
+            + (seed >> 2);
+    return seed;
 }
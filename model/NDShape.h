@@ -2,15 +2,103 @@
 #define NDSHAPE_H
 
 #include <vector>
-#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <cstddef>
+#include <iterator>
+#include "adjacencyBitMatrix.h"
+
+/**
+ * @brief Non-owning, read-only view of one vertex's coordinates.
+ *
+ * Valid until the owning NDShape is modified or destroyed.
+ */
+class CoordSpan {
+public:
+    CoordSpan() = default;
+    CoordSpan(const double* data, std::size_t size) : data_(data), size_(size) {}
+
+    const double* data()  const { return data_; }
+    std::size_t   size()  const { return size_; }
+    bool          empty() const { return size_ == 0; }
+    const double* begin() const { return data_; }
+    const double* end()   const { return data_ + size_; }
+    double operator[](std::size_t i) const { return data_[i]; }
+
+    /// Copies the viewed coordinates into an owning vector.
+    std::vector<double> toVector() const { return std::vector<double>(begin(), end()); }
+
+private:
+    const double* data_ = nullptr;
+    std::size_t   size_ = 0;
+};
 
 /**
  * @brief NDShape represents a multidimensional figure using a simple B-rep model.
+ *
+ * Vertex coordinates are stored in a single contiguous vertex-major buffer
+ * (one row of getDimension() doubles per vertex) together with a dense
+ * ID → slot index, so transforms can stream over the coordinates without
+ * chasing per-vertex allocations. Slots are read in ascending ID order;
+ * removeVertex() may leave them out of order, and the next read restores it.
+ *
+ * The vertex buffers and the edge buffers are reference-counted and shared
+ * copy-on-write: copying a shape is O(1), and a copy's buffers are duplicated
+ * only on its first modification. Raw pointers and views obtained from a
+ * shape stay tied to that shape and are invalidated by its modification.
  */
 class NDShape {
 public:
+    /// One element of vertices(): a vertex ID and a view of its coordinates.
+    struct VertexRef {
+        std::size_t id;
+        CoordSpan   coords;
+    };
+
+    /// Forward iterator over (ID, coordinates) in ascending ID order.
+    class VertexIterator {
+    public:
+        using value_type        = VertexRef;
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = VertexRef;
+
+        VertexIterator(const NDShape* shape, std::size_t slot) : shape_(shape), slot_(slot) {}
+
+        VertexRef operator*() const {
+            const VertexStore& v = shape_->verts();
+            return { v.slotIds[slot_],
+                     CoordSpan(v.coords.data() + slot_ * shape_->dimension_, shape_->dimension_) };
+        }
+        VertexIterator& operator++() { ++slot_; return *this; }
+        bool operator==(const VertexIterator& o) const { return slot_ == o.slot_; }
+        bool operator!=(const VertexIterator& o) const { return slot_ != o.slot_; }
+
+    private:
+        const NDShape* shape_;
+        std::size_t    slot_;
+    };
+
+    /// Lightweight range returned by vertices(); allocates nothing.
+    class VertexRange {
+    public:
+        explicit VertexRange(const NDShape* shape) : shape_(shape) {}
+        VertexIterator begin() const { return { shape_, 0 }; }
+        VertexIterator end()   const { return { shape_, size() }; }
+        std::size_t    size()  const { return shape_->verts().slotIds.size(); }
+        bool           empty() const { return size() == 0; }
+
+    private:
+        const NDShape* shape_;
+    };
+
+    /// Marks a vertex ID that does not exist (e.g. in the remap returned by compact()).
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
     NDShape() = default;
     ~NDShape() = default;
     /**
@@ -38,6 +126,18 @@ public:
      */
     std::size_t addVertex(const std::vector<double>& coords);
 
+    /**
+     * @brief Appends @p count vertices stored row-major in @p flat.
+     *
+     * Only the vertex buffers are written; edges and incidence stay shared
+     * with any copy of the shape. IDs are assigned consecutively.
+     *
+     * @param flat  count × getDimension() coordinates.
+     * @param count Number of vertices to add.
+     * @return The ID of the first added vertex.
+     */
+    std::size_t addVertices(const double* flat, std::size_t count);
+
     /**
      * @brief Adds an edge connecting two existing vertices by their IDs.
      *
@@ -60,9 +160,46 @@ public:
      *  - second = coordinate vector of that vertex
      *
      * @return A vector of (ID, coordinates) pairs.
+     *
+     * @note Deep-copies every coordinate; prefer vertices() for read-only traversal.
      */
     std::vector<std::pair<std::size_t, std::vector<double>>> getAllVertices() const;
 
+    /**
+     * @brief Iterates over all vertices without copying.
+     *
+     * Yields VertexRef{id, coords} in ascending ID order, e.g.
+     * `for (auto [id, coords] : shape.vertices())`. The views are
+     * invalidated by any modification of the shape.
+     *
+     * @return A non-owning range over the vertices.
+     */
+    VertexRange vertices() const { return VertexRange(this); }
+
+    /**
+     * @brief Returns a non-owning view of a single vertex's coordinates.
+     *
+     * @param vertexId The ID of the vertex to look up.
+     * @return A CoordSpan of getDimension() elements.
+     * @throws std::out_of_range If no vertex with that ID exists.
+     */
+    CoordSpan vertexCoords(std::size_t vertexId) const;
+
+    /**
+     * @brief All vertex IDs in ascending order (row k of coordinateData()).
+     */
+    const std::vector<std::size_t>& vertexIds() const { return verts().slotIds; }
+
+    /**
+     * @brief Raw coordinate buffer: verticesSize() rows of getDimension()
+     *        doubles, ordered like vertexIds().
+     *
+     * The mutable overload lets transforms rewrite coordinates in place;
+     * it first unshares the vertex buffers if another copy still uses them.
+     */
+    const double* coordinateData() const { return verts().coords.data(); }
+    double*       coordinateData()       { verts(); return mutableVerts().coords.data(); }
+
     /**
      * @brief Updates the coordinates of an existing vertex.
      *
@@ -79,14 +216,32 @@ public:
      * @brief Retrieves the coordinates of a single vertex by its ID.
      *
      * @param vertexId The ID of the vertex to look up.
-     * @return A const reference to the coordinate vector of that vertex.
+     * @return A copy of the coordinate vector of that vertex.
      * @throws std::out_of_range If no vertex with that ID exists.
      */
-    const std::vector<double>& getVertex(std::size_t vertexId) const;
+    std::vector<double> getVertex(std::size_t vertexId) const;
+
+    /**
+     * @brief Checks whether an edge connects the two vertices (in either direction).
+     *
+     * Runs in O(1) using the internal edge index. Unknown IDs or
+     * id1 == id2 simply yield false.
+     *
+     * @param id1 The ID of the first vertex.
+     * @param id2 The ID of the second vertex.
+     * @return True if the edge exists.
+     */
+    bool hasEdge(std::size_t id1, std::size_t id2) const;
 
     /**
      * @brief Retrieves the edges of this shape as pairs of vertex IDs.
      *
+     * The order is not meaningful. addEdge() appends, and the batched
+     * removals keep the order of the remaining edges. removeEdge() and
+     * removeVertex() move the last edge into each freed position instead,
+     * and compact() sorts the edges. Callers that need a stable order must
+     * sort the edges themselves.
+     *
      * @return A const reference to the vector of edges.
      */
     const std::vector<std::pair<std::size_t, std::size_t>>& getEdges() const;
@@ -101,6 +256,9 @@ public:
      *      - If `newDim` > original dimension, new components are zero-initialized.
      *  - Preserve the internal `vertexCounter_` so future vertex IDs continue sequentially.
      *
+     * The edge buffers are shared with this shape; at the same dimension the
+     * result is a plain copy-on-write copy.
+     *
      * @param newDim  The target dimension for the clone; must be > 0.
      * @return        A new NDShape instance matching this shape’s topology,
      *                resized to `newDim`.
@@ -111,7 +269,12 @@ public:
     /**
      * @brief Removes the vertex with the given ID.
      *
-     * Also removes any edges incident to this vertex.
+     * Also removes any edges incident to this vertex; only those edges
+     * are touched, via the per-vertex incidence list, and each one is
+     * replaced by the last edge as in removeEdge(). The last slot is
+     * moved into the gap, so the call costs O(dim + degree); the ascending
+     * slot order is restored in one O(V) pass by the next read, however
+     * many vertices were removed before it.
      *
      * @param vertexId The ID of the vertex to remove.
      * @throws std::out_of_range If the vertex does not exist.
@@ -122,7 +285,8 @@ public:
      * @brief Removes an edge connecting two vertices.
      *
      * The function removes all occurrences of an edge between the specified vertices.
-     * If the edge does not exist, an exception is thrown.
+     * If the edge does not exist, an exception is thrown. Runs in O(1): the
+     * last edge of getEdges() takes the removed edge's position.
      *
      * @param id1 The ID of the first vertex.
      * @param id2 The ID of the second vertex.
@@ -130,6 +294,28 @@ public:
      */
     void removeEdge(std::size_t id1, std::size_t id2);
 
+    /**
+     * @brief Removes several vertices and all their incident edges at once.
+     *
+     * Victims are marked in a bitset and the coordinate buffer and edge
+     * list are each compacted in a single linear pass, so removing k
+     * vertices costs O(V + E) rather than O(k·E). Duplicate IDs are ignored.
+     *
+     * @param vertexIds IDs of the vertices to remove.
+     * @throws std::out_of_range If any ID does not exist (nothing is removed then).
+     */
+    void removeVertices(const std::vector<std::size_t>& vertexIds);
+
+    /**
+     * @brief Removes several edges at once with a single compaction pass.
+     *
+     * Each pair may be given in either orientation; duplicates are ignored.
+     *
+     * @param edges Vertex ID pairs of the edges to remove.
+     * @throws std::out_of_range If any edge does not exist (nothing is removed then).
+     */
+    void removeEdges(const std::vector<std::pair<std::size_t, std::size_t>>& edges);
+
     /**
      * @brief Returns the vertices adjacency matrix with their IDs as headers.
      *
@@ -142,6 +328,29 @@ public:
      */
     std::vector<std::vector<int>> getAdjacencyMatrix() const;
 
+    /**
+     * @brief Returns the adjacency matrix in packed form.
+     *
+     * Row/column k corresponds to the k-th vertex ID in ascending order
+     * (the same order as the headers of getAdjacencyMatrix()).
+     * Built in O(V²/64 + E) from the edge list.
+     *
+     * @return An AdjacencyBitMatrix of size verticesSize().
+     */
+    AdjacencyBitMatrix getAdjacencyBits() const;
+
+    /**
+     * @brief Makes the edge set equal to the given packed adjacency matrix.
+     *
+     * The current matrix is XOR-ed with @p target and only the differing
+     * pairs are visited, adding or removing the corresponding edges in a
+     * single pass.
+     *
+     * @param target Desired adjacency, indexed like getAdjacencyBits().
+     * @throws std::invalid_argument If target.size() != verticesSize().
+     */
+    void applyAdjacencyBits(const AdjacencyBitMatrix& target);
+
     /**
      * @brief Updates the NDShape's edges based on the provided adjacency matrix data.
      *
@@ -156,14 +365,102 @@ public:
      */
     void updateFromAdjacencyMatrix(const std::vector<std::vector<int>>& matrix);
 
+    /**
+     * @brief Renumbers the vertices densely as 0..verticesSize()-1.
+     *
+     * New IDs follow a breadth-first traversal of the edge graph (each
+     * component rooted at its lowest old ID, neighbours in ascending ID
+     * order), so adjacent vertices end up in neighbouring rows of the
+     * coordinate buffer. Edges are reordered by their new endpoints.
+     * Afterwards new vertex IDs continue from verticesSize().
+     *
+     * @return Remap indexed by old vertex ID: the new ID, or npos for IDs
+     *         that were not in use.
+     */
+    std::vector<std::size_t> compact();
+
     int verticesSize() const;
     int edgesSize() const;
 
+    /**
+     * @brief Whether this shape and @p other are unmodified copies of each other.
+     *
+     * True when both still share their vertex and edge buffers, i.e. neither
+     * has been written since one was copied from the other. O(1); shapes
+     * with equal content but separate buffers compare false.
+     */
+    bool sharesDataWith(const NDShape& other) const;
+
 private:
-    std::size_t dimension_;
-    std::map<std::size_t, std::vector<double>> vertices_;
-    std::vector<std::pair<std::size_t, std::size_t>> edges_;
-    std::size_t vertexCounter_;
+    friend class NDShapeBuilder;
+
+    using Edge = std::pair<std::size_t, std::size_t>;
+
+    struct EdgeHash {
+        std::size_t operator()(const Edge& e) const noexcept;
+    };
+
+    /// Returns the storage slot of @p vertexId, or npos if it does not exist.
+    std::size_t slotOf(std::size_t vertexId) const;
+
+    /// Canonical (min, max) key used by the edge index.
+    static Edge edgeKey(std::size_t id1, std::size_t id2);
+
+    /// Removes edges_[pos] in O(1) by swapping in the last edge.
+    void eraseEdgeAt(std::size_t pos);
+
+    /// Drops every edge whose flag is set, keeping the order of the rest,
+    /// and updates the edge index and incidence lists accordingly.
+    void compactEdges(const std::vector<bool>& removedEdges);
+
+    /// Vertex coordinates and the ID <-> slot index; shared between copies.
+    struct VertexStore {
+        std::vector<double>      coords;    ///< slot-major: slot s -> [s*dim, (s+1)*dim)
+        std::vector<std::size_t> slotIds;   ///< slot -> vertex ID (ascending unless unordered)
+        std::vector<std::size_t> idToSlot;  ///< vertex ID -> slot (npos if removed)
+
+        /// Set by removeVertex(); cleared by restoreSlotOrder() under orderMutex.
+        mutable std::atomic<bool> unordered{false};
+        mutable std::mutex        orderMutex;
+
+        VertexStore() = default;
+        VertexStore(const VertexStore& other);
+    };
+
+    /// Edge list and its lookup structures; shared between copies.
+    struct TopologyStore {
+        std::vector<Edge> edges;
+        std::unordered_map<Edge, std::size_t, EdgeHash> edgeIndex;  ///< canonical edge -> position in edges
+        std::vector<std::vector<std::size_t>> incidence;            ///< vertex ID -> neighbour IDs (grown lazily)
+    };
+
+    /// Read access with the slots in ascending ID order; a shape without
+    /// buffers (fresh or moved-from) reads as empty.
+    const VertexStore& verts() const {
+        if (verts_ && verts_->unordered.load(std::memory_order_acquire))
+            restoreSlotOrder();
+        return indexedVerts();
+    }
+    const TopologyStore& topo() const { return topo_ ? *topo_ : emptyTopo_; }
+
+    /// Read access for ID lookups, which do not need the slots in order.
+    const VertexStore& indexedVerts() const { return verts_ ? *verts_ : emptyVerts_; }
+
+    /// Sorts the slots of the vertex store back into ascending ID order.
+    /// Thread-safe, since copies sharing the store may read it concurrently.
+    void restoreSlotOrder() const;
+
+    /// Write access; allocates the buffers or unshares them if another copy holds them.
+    VertexStore&   mutableVerts();
+    TopologyStore& mutableTopo();
+
+    static const VertexStore   emptyVerts_;
+    static const TopologyStore emptyTopo_;
+
+    std::size_t dimension_ = 0;
+    std::shared_ptr<VertexStore>   verts_;
+    std::shared_ptr<TopologyStore> topo_;
+    std::size_t vertexCounter_ = 0;
 };
 
 #endif // NDSHAPE_H
@@ -0,0 +1,199 @@
+#include "NDShapeBuilder.h"
+#include <QDebug>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+NDShapeBuilder::NDShapeBuilder(std::size_t dimension,
+                               std::size_t vertexCapacity,
+                               std::size_t edgeCapacity)
+    : shape_(dimension)
+    , verts_(&shape_.mutableVerts())
+    , topo_(&shape_.mutableTopo())
+{
+    verts_->coords.reserve(vertexCapacity * dimension);
+    verts_->slotIds.reserve(vertexCapacity);
+    topo_->edges.reserve(edgeCapacity);
+}
+
+NDShapeBuilder::NDShapeBuilder(NDShape base,
+                               std::size_t extraVertices,
+                               std::size_t extraEdges)
+    : shape_(std::move(base))
+{
+    if (shape_.dimension_ == 0) {
+        QString msg = "Dimension must be greater than zero.";
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+    // sort any slots removeVertex() left out of order, then unshare the
+    // buffers once; the builder owns them exclusively from here on
+    shape_.verts();
+    verts_ = &shape_.mutableVerts();
+    topo_  = &shape_.mutableTopo();
+    firstNewSlot_ = verts_->slotIds.size();
+    firstNewEdge_ = topo_->edges.size();
+    verts_->coords.reserve(verts_->coords.size() + extraVertices * shape_.dimension_);
+    verts_->slotIds.reserve(verts_->slotIds.size() + extraVertices);
+    topo_->edges.reserve(topo_->edges.size() + extraEdges);
+}
+
+std::size_t NDShapeBuilder::addVertex(const double* coords)
+{
+    std::size_t id = shape_.vertexCounter_++;
+    verts_->slotIds.push_back(id);
+    verts_->coords.insert(verts_->coords.end(), coords, coords + shape_.dimension_);
+    return id;
+}
+
+std::size_t NDShapeBuilder::addVertex(const std::vector<double>& coords)
+{
+    if (coords.size() != shape_.dimension_) {
+        QString msg = "Coordinate count does not match shape dimension.";
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+    return addVertex(coords.data());
+}
+
+std::size_t NDShapeBuilder::addVertices(const double* flat, std::size_t count)
+{
+    std::size_t first = shape_.vertexCounter_;
+    verts_->coords.insert(verts_->coords.end(), flat, flat + count * shape_.dimension_);
+    for (std::size_t i = 0; i < count; ++i)
+        verts_->slotIds.push_back(first + i);
+    shape_.vertexCounter_ += count;
+    return first;
+}
+
+void NDShapeBuilder::addVertexWithId(std::size_t id, const std::vector<double>& coords)
+{
+    if (coords.size() != shape_.dimension_) {
+        QString msg = "Coordinate count does not match shape dimension.";
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+    verts_->slotIds.push_back(id);
+    verts_->coords.insert(verts_->coords.end(), coords.begin(), coords.end());
+    shape_.vertexCounter_ = std::max(shape_.vertexCounter_, id + 1);
+}
+
+void NDShapeBuilder::addEdge(std::size_t id1, std::size_t id2)
+{
+    topo_->edges.emplace_back(id1, id2);
+}
+
+void NDShapeBuilder::addEdges(const std::pair<std::size_t, std::size_t>* edges, std::size_t count)
+{
+    topo_->edges.insert(topo_->edges.end(), edges, edges + count);
+}
+
+NDShape NDShapeBuilder::finish()
+{
+    validateVertices();
+    validateEdges();
+    indexEdges();
+    return std::move(shape_);
+}
+
+void NDShapeBuilder::validateVertices()
+{
+    auto& ids = verts_->slotIds;
+    const std::size_t dim = shape_.dimension_;
+
+    // already-indexed slots are sorted; only the appended tail needs checking
+    std::size_t from = firstNewSlot_ ? firstNewSlot_ - 1 : 0;
+    bool sorted = std::adjacent_find(ids.begin() + from, ids.end(),
+                                     [](std::size_t a, std::size_t b) { return a >= b; }) == ids.end();
+
+    if (!sorted) {
+        std::vector<std::size_t> order(ids.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&ids](std::size_t a, std::size_t b) { return ids[a] < ids[b]; });
+
+        for (std::size_t k = 1; k < order.size(); ++k) {
+            if (ids[order[k]] == ids[order[k - 1]]) {
+                QString msg = QString("Duplicate vertex ID %1.").arg(ids[order[k]]);
+                qWarning() << msg;
+                throw std::invalid_argument(msg.toStdString());
+            }
+        }
+
+        std::vector<double>      coords(verts_->coords.size());
+        std::vector<std::size_t> sortedIds(ids.size());
+        for (std::size_t k = 0; k < order.size(); ++k) {
+            sortedIds[k] = ids[order[k]];
+            std::copy_n(verts_->coords.begin() + order[k] * dim, dim, coords.begin() + k * dim);
+        }
+        verts_->coords = std::move(coords);
+        ids            = std::move(sortedIds);
+        from           = 0;
+    } else {
+        from = firstNewSlot_;
+    }
+
+    verts_->idToSlot.resize(shape_.vertexCounter_, NDShape::npos);
+    topo_->incidence.resize(shape_.vertexCounter_);
+    for (std::size_t slot = from; slot < ids.size(); ++slot)
+        verts_->idToSlot[ids[slot]] = slot;
+}
+
+void NDShapeBuilder::validateEdges() const
+{
+    const auto*       edges = topo_->edges.data();
+    const std::size_t count = topo_->edges.size();
+    const std::size_t limit = shape_.vertexCounter_;
+
+    // branch-free range/self-loop check over the whole batch
+    bool bad = false;
+    for (std::size_t i = firstNewEdge_; i < count; ++i)
+        bad |= (edges[i].first >= limit) | (edges[i].second >= limit)
+             | (edges[i].first == edges[i].second);
+
+    // IDs below the counter may still be holes (removed or never loaded)
+    const bool hasHoles = verts_->slotIds.size() != limit;
+    if (!bad && !hasHoles) return;
+
+    for (std::size_t i = firstNewEdge_; i < count; ++i) {
+        const auto [a, b] = edges[i];
+        if (shape_.slotOf(a) == NDShape::npos || shape_.slotOf(b) == NDShape::npos) {
+            QString msg = "One or both vertex IDs do not exist.";
+            qWarning() << msg;
+            throw std::out_of_range(msg.toStdString());
+        }
+        if (a == b) {
+            QString msg = "Edges with the same vertices are forbidden.";
+            qWarning() << msg;
+            throw std::invalid_argument(msg.toStdString());
+        }
+    }
+}
+
+void NDShapeBuilder::indexEdges()
+{
+    const auto&       edges = topo_->edges;
+    const std::size_t count = edges.size();
+
+    topo_->edgeIndex.reserve(count);
+    for (std::size_t i = firstNewEdge_; i < count; ++i) {
+        if (!topo_->edgeIndex.emplace(NDShape::edgeKey(edges[i].first, edges[i].second), i).second) {
+            QString msg = "Edge already exists.";
+            qWarning() << msg;
+            throw std::invalid_argument(msg.toStdString());
+        }
+    }
+
+    // size incidence lists up front, then fill
+    std::vector<std::size_t> degree(shape_.vertexCounter_, 0);
+    for (std::size_t i = firstNewEdge_; i < count; ++i) {
+        ++degree[edges[i].first];
+        ++degree[edges[i].second];
+    }
+    for (std::size_t id = 0; id < degree.size(); ++id)
+        if (degree[id]) topo_->incidence[id].reserve(topo_->incidence[id].size() + degree[id]);
+    for (std::size_t i = firstNewEdge_; i < count; ++i) {
+        topo_->incidence[edges[i].first].push_back(edges[i].second);
+        topo_->incidence[edges[i].second].push_back(edges[i].first);
+    }
+}
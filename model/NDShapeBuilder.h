@@ -0,0 +1,104 @@
+#ifndef NDSHAPE_BUILDER_H
+#define NDSHAPE_BUILDER_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "NDShape.h"
+
+/**
+ * @brief Bulk constructor for NDShape.
+ *
+ * Vertices and edges are appended without per-element checks or logging;
+ * everything is validated once in finish(), which then builds the ID and
+ * edge indices in a single pass and moves the result into an NDShape.
+ * Intended for generators and loaders that create whole shapes at once.
+ *
+ * @code
+ *   NDShapeBuilder b(3, vertexCount, edgeCount);
+ *   std::size_t first = b.addVertices(flatCoords.data(), vertexCount);
+ *   b.addEdges(edgeList.data(), edgeList.size());
+ *   NDShape shape = b.finish();
+ * @endcode
+ */
+class NDShapeBuilder {
+public:
+    /**
+     * @brief Starts an empty shape.
+     * @param dimension      The dimension of the shape; must be > 0.
+     * @param vertexCapacity Number of vertices to reserve room for.
+     * @param edgeCapacity   Number of edges to reserve room for.
+     * @throws std::invalid_argument If dimension is zero.
+     */
+    NDShapeBuilder(std::size_t dimension,
+                   std::size_t vertexCapacity = 0,
+                   std::size_t edgeCapacity   = 0);
+
+    /**
+     * @brief Continues building on top of an existing shape.
+     *
+     * Takes over the storage of @p base; new vertex IDs continue after
+     * its last assigned ID.
+     */
+    explicit NDShapeBuilder(NDShape     base,
+                            std::size_t extraVertices = 0,
+                            std::size_t extraEdges    = 0);
+
+    std::size_t getDimension() const { return shape_.dimension_; }
+
+    /**
+     * @brief Appends one vertex; reads getDimension() values from @p coords.
+     * @return The ID the vertex will have in the finished shape.
+     */
+    std::size_t addVertex(const double* coords);
+
+    /**
+     * @brief Appends one vertex.
+     * @throws std::invalid_argument If coords.size() != getDimension().
+     */
+    std::size_t addVertex(const std::vector<double>& coords);
+
+    /**
+     * @brief Appends @p count vertices from a flat vertex-major array of
+     *        count * getDimension() values.
+     * @return The ID of the first appended vertex; the rest follow sequentially.
+     */
+    std::size_t addVertices(const double* flat, std::size_t count);
+
+    /**
+     * @brief Appends a vertex with a caller-chosen ID (e.g. when loading).
+     *
+     * IDs may arrive in any order; uniqueness is checked in finish().
+     * @throws std::invalid_argument If coords.size() != getDimension().
+     */
+    void addVertexWithId(std::size_t id, const std::vector<double>& coords);
+
+    /// Appends an edge between two vertex IDs; validated in finish().
+    void addEdge(std::size_t id1, std::size_t id2);
+
+    /// Appends @p count edges; validated in finish().
+    void addEdges(const std::pair<std::size_t, std::size_t>* edges, std::size_t count);
+
+    /**
+     * @brief Validates all pending data and returns the finished shape.
+     *
+     * The builder must not be used afterwards, nor after finish() threw.
+     *
+     * @throws std::invalid_argument On duplicate vertex IDs, self-loops or duplicate edges.
+     * @throws std::out_of_range If an edge refers to a vertex that does not exist.
+     */
+    NDShape finish();
+
+private:
+    void validateVertices();
+    void validateEdges() const;
+    void indexEdges();
+
+    NDShape                 shape_;
+    NDShape::VertexStore*   verts_ = nullptr;   ///< shape_'s unshared vertex buffers
+    NDShape::TopologyStore* topo_  = nullptr;   ///< shape_'s unshared edge buffers
+    std::size_t             firstNewSlot_ = 0;   ///< vertices before this slot are already indexed
+    std::size_t             firstNewEdge_ = 0;   ///< edges before this position are already indexed
+};
+
+#endif // NDSHAPE_BUILDER_H
@@ -0,0 +1,65 @@
+#include "adjacencyBitMatrix.h"
+#include <stdexcept>
+#include <utility>
+
+AdjacencyBitMatrix::AdjacencyBitMatrix(std::size_t n)
+    : n_(n)
+    , words_((n * (n ? n - 1 : 0) / 2 + 63) / 64, 0)
+{
+}
+
+std::size_t AdjacencyBitMatrix::bitIndex(std::size_t i, std::size_t j) const
+{
+    // rows 0..i-1 hold (n-1) + (n-2) + ... + (n-i) bits
+    return i * (2 * n_ - i - 1) / 2 + (j - i - 1);
+}
+
+bool AdjacencyBitMatrix::test(std::size_t i, std::size_t j) const
+{
+    if (i >= n_ || j >= n_)
+        throw std::out_of_range("AdjacencyBitMatrix::test: index out of range");
+    if (i == j) return false;
+    if (i > j) std::swap(i, j);
+    const std::size_t b = bitIndex(i, j);
+    return (words_[b / 64] >> (b % 64)) & 1u;
+}
+
+void AdjacencyBitMatrix::set(std::size_t i, std::size_t j, bool value)
+{
+    if (i >= n_ || j >= n_)
+        throw std::out_of_range("AdjacencyBitMatrix::set: index out of range");
+    if (i == j)
+        throw std::invalid_argument("AdjacencyBitMatrix::set: diagonal cells cannot be set");
+    if (i > j) std::swap(i, j);
+    const std::size_t b = bitIndex(i, j);
+    const std::uint64_t mask = std::uint64_t(1) << (b % 64);
+    if (value) words_[b / 64] |=  mask;
+    else       words_[b / 64] &= ~mask;
+}
+
+std::size_t AdjacencyBitMatrix::count() const
+{
+    std::size_t total = 0;
+    for (std::uint64_t w : words_) {
+        // SWAR popcount, portable across compilers
+        w = w - ((w >> 1) & 0x5555555555555555ULL);
+        w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+        w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        total += static_cast<std::size_t>((w * 0x0101010101010101ULL) >> 56);
+    }
+    return total;
+}
+
+AdjacencyBitMatrix& AdjacencyBitMatrix::operator^=(const AdjacencyBitMatrix& other)
+{
+    if (other.n_ != n_)
+        throw std::invalid_argument("AdjacencyBitMatrix: size mismatch");
+    for (std::size_t w = 0; w < words_.size(); ++w)
+        words_[w] ^= other.words_[w];
+    return *this;
+}
+
+bool AdjacencyBitMatrix::operator==(const AdjacencyBitMatrix& other) const
+{
+    return n_ == other.n_ && words_ == other.words_;
+}
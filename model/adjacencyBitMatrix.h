@@ -0,0 +1,102 @@
+#ifndef ADJACENCY_BIT_MATRIX_H
+#define ADJACENCY_BIT_MATRIX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Packed symmetric adjacency matrix of an undirected simple graph.
+ *
+ * Only the strict upper triangle is stored, one bit per vertex pair,
+ * so an n-vertex matrix takes n·(n-1)/2 bits. Rows and columns are
+ * plain indices 0..n-1; NDShape maps them to vertex IDs in ascending order.
+ */
+class AdjacencyBitMatrix {
+public:
+    AdjacencyBitMatrix() = default;
+
+    /**
+     * @brief Creates an n x n matrix with no edges.
+     * @param n Number of rows (and columns).
+     */
+    explicit AdjacencyBitMatrix(std::size_t n);
+
+    /// Number of rows (and columns).
+    std::size_t size() const { return n_; }
+
+    /**
+     * @brief Tests whether cell (i, j) is set. The diagonal is always false.
+     * @throws std::out_of_range If i or j is not below size().
+     */
+    bool test(std::size_t i, std::size_t j) const;
+
+    /**
+     * @brief Sets or clears cell (i, j) together with its mirror (j, i).
+     * @throws std::out_of_range If i or j is not below size().
+     * @throws std::invalid_argument If i == j.
+     */
+    void set(std::size_t i, std::size_t j, bool value = true);
+
+    /// Number of set pairs (edges).
+    std::size_t count() const;
+
+    /**
+     * @brief Word-wise XOR with a matrix of the same size; the result marks
+     *        every pair that differs between the two.
+     * @throws std::invalid_argument If sizes differ.
+     */
+    AdjacencyBitMatrix& operator^=(const AdjacencyBitMatrix& other);
+
+    bool operator==(const AdjacencyBitMatrix& other) const;
+    bool operator!=(const AdjacencyBitMatrix& other) const { return !(*this == other); }
+
+    /**
+     * @brief Calls f(i, j) with i < j for every set pair, in row-major order.
+     *
+     * Runs in O(size() + words + set pairs): empty words are skipped whole.
+     */
+    template<typename F>
+    void forEachSetPair(F&& f) const
+    {
+        if (n_ < 2) return;
+        std::size_t row = 0, rowBegin = 0, rowEnd = n_ - 1;
+        for (std::size_t w = 0; w < words_.size(); ++w) {
+            std::uint64_t bits = words_[w];
+            while (bits) {
+                const std::size_t pos = w * 64 + countTrailingZeros(bits);
+                bits &= bits - 1;
+                while (pos >= rowEnd) {
+                    ++row;
+                    rowBegin = rowEnd;
+                    rowEnd  += n_ - 1 - row;
+                }
+                f(row, row + 1 + (pos - rowBegin));
+            }
+        }
+    }
+
+private:
+    /// Linear bit position of the pair (i, j), i < j.
+    std::size_t bitIndex(std::size_t i, std::size_t j) const;
+
+    static unsigned countTrailingZeros(std::uint64_t v)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward64(&idx, v);
+        return static_cast<unsigned>(idx);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+    }
+
+    std::size_t                n_ = 0;
+    std::vector<std::uint64_t> words_;
+};
+
+#endif // ADJACENCY_BIT_MATRIX_H
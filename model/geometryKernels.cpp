@@ -0,0 +1,257 @@
+#include "geometryKernels.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <variant>
+#include "simdKernels.h"
+
+namespace {
+
+template<std::size_t N>
+constexpr KernelTable makeTable()
+{
+    return { N,
+             &Kernels<N>::rotatePlane,
+             &Kernels<N>::transformRows,
+             &Kernels<N>::projectPerspective,
+             &Kernels<N>::projectOrthographic,
+             &Kernels<N>::projectStereographic,
+             &Kernels<N>::scaleOffset,
+             &Kernels<N>::convertHomogeneous,
+             &Kernels<N>::convertHomogeneousSingle,
+             &::rotateColumns,
+             &::convertDiagonal,
+             &::convertDiagonalSingle };
+}
+
+template<std::size_t... I>
+constexpr std::array<KernelTable, sizeof...(I)> makeTables(std::index_sequence<I...>)
+{
+    return { makeTable<kMinKernelDimension + I>()... };
+}
+
+constexpr KernelTable kGenericTable = makeTable<0>();
+
+constexpr auto kTables = makeTables(
+    std::make_index_sequence<kMaxKernelDimension - kMinKernelDimension + 1>{});
+
+constexpr std::size_t kLevelCount = 3;
+using TableSet = std::array<KernelTable, kMaxKernelDimension - kMinKernelDimension + 1>;
+
+/// Specialised tables with the vector entries of @p level swapped in.
+TableSet tablesFor(SimdLevel level)
+{
+    TableSet tables = kTables;
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    for (KernelTable& t : tables) {
+        if (level == SimdLevel::AVX2) {
+            t.rotatePlane          = &simd::avx2::rotatePlane;
+            t.projectPerspective   = &simd::avx2::projectPerspective;
+            t.projectStereographic = &simd::avx2::projectStereographic;
+            t.convertHomogeneous   = &simd::avx2::convertHomogeneous;
+            t.convertHomogeneousSingle = &simd::avx2::convertHomogeneousSingle;
+            t.rotateColumns        = &simd::avx2::rotateColumns;
+            t.convertDiagonal      = &simd::avx2::convertDiagonal;
+            t.convertDiagonalSingle = &simd::avx2::convertDiagonalSingle;
+        } else if (level == SimdLevel::SSE41) {
+            t.rotatePlane          = &simd::sse41::rotatePlane;
+            t.projectPerspective   = &simd::sse41::projectPerspective;
+            t.projectStereographic = &simd::sse41::projectStereographic;
+            t.convertHomogeneous   = &simd::sse41::convertHomogeneous;
+            t.convertHomogeneousSingle = &simd::sse41::convertHomogeneousSingle;
+            t.rotateColumns        = &simd::sse41::rotateColumns;
+            t.convertDiagonal      = &simd::sse41::convertDiagonal;
+            t.convertDiagonalSingle = &simd::sse41::convertDiagonalSingle;
+        }
+    }
+#else
+    (void)level;
+#endif
+    return tables;
+}
+
+const std::array<TableSet, kLevelCount>& allTables()
+{
+    static const std::array<TableSet, kLevelCount> tables = {
+        tablesFor(SimdLevel::Scalar), tablesFor(SimdLevel::SSE41), tablesFor(SimdLevel::AVX2)
+    };
+    return tables;
+}
+
+/// Adds sign · (rotated rows t..n-1) to the projective row @p w.
+void foldDroppedRows(double* m, std::size_t n, std::size_t t, double sign)
+{
+    const std::size_t s = n + 1;
+    double* w = m + n * s;
+    for (std::size_t k = t; k < n; ++k)
+        for (std::size_t j = 0; j < n; ++j)
+            w[j] += sign * m[k * s + j];
+}
+
+/// Writes the projective part of @p proj into the homogeneous matrix @p m;
+/// returns whether a divide by w is needed. One overload per alternative.
+struct ProjectiveFold {
+    double*     m;
+    std::size_t n;
+    std::size_t t;
+
+    bool operator()(std::monostate) const { return false; }
+    bool operator()(const OrthographicParams&) const { return false; }
+
+    bool operator()(const PerspectiveParams& p) const
+    {
+        const std::size_t s = n + 1;
+        foldDroppedRows(m, n, t, 1.0);
+        m[n * s + n] = p.distance;
+        for (std::size_t i = 0; i < t; ++i)
+            for (std::size_t j = 0; j < s; ++j)
+                m[i * s + j] *= p.distance;
+        return true;
+    }
+
+    bool operator()(const StereographicParams&) const
+    {
+        foldDroppedRows(m, n, t, -1.0);
+        return true;
+    }
+};
+
+template<class T>
+std::size_t convertDiagonalAs(const double* const* columns, T* out, std::size_t count,
+                              std::size_t dim, std::size_t targetDim,
+                              const T* m, const T* offset, bool divide, unsigned char* valid,
+                              std::size_t outStride)
+{
+    // 1/w is gathered per block, so every column is streamed once and each
+    // vertex costs one division
+    constexpr std::size_t kBlock = 256;
+    const std::size_t n = dim;
+    const T* wRow = m + n * (n + 1);
+    std::array<T, kBlock> w;
+    auto diag = [m, n](std::size_t i) { return m[i * (n + 2)]; };
+    auto o    = [offset](std::size_t i) { return offset ? offset[i] : T(0); };
+
+    std::size_t invalid = 0;
+    for (std::size_t b = 0; b < count; b += kBlock) {
+        const std::size_t len = std::min(kBlock, count - b);
+        w.fill(divide ? wRow[n] : T(1));
+        if (divide) {
+            for (std::size_t j = targetDim; j < n; ++j) {
+                const double* x = columns[j] + b;
+                for (std::size_t v = 0; v < len; ++v)
+                    w[v] += wRow[j] * static_cast<T>(x[v]);
+            }
+            for (std::size_t v = 0; v < len; ++v) {
+                const bool ok = std::fabs(w[v]) >= kMinDenominator<T>;
+                invalid += !ok;
+                if (valid)
+                    valid[b + v] = ok;
+                w[v] = T(1) / w[v];
+            }
+        } else if (valid) {
+            std::fill(valid + b, valid + b + len, 1);
+        }
+
+        T* dst = out + b * outStride;
+        if (targetDim == 3) {
+            // the scene's usual target, written one vertex at a time
+            const double* x0 = columns[0] + b;
+            const double* x1 = columns[1] + b;
+            const double* x2 = columns[2] + b;
+            const T d0 = diag(0), d1 = diag(1), d2 = diag(2);
+            const T o0 = o(0),    o1 = o(1),    o2 = o(2);
+            for (std::size_t v = 0; v < len; ++v, dst += outStride) {
+                dst[0] = d0 * static_cast<T>(x0[v]) * w[v] + o0;
+                dst[1] = d1 * static_cast<T>(x1[v]) * w[v] + o1;
+                dst[2] = d2 * static_cast<T>(x2[v]) * w[v] + o2;
+            }
+            continue;
+        }
+        for (std::size_t i = 0; i < targetDim; ++i) {
+            const double* x  = columns[i] + b;
+            const T       di = diag(i);
+            const T       oi = o(i);
+            for (std::size_t v = 0; v < len; ++v)
+                dst[v * outStride + i] = di * static_cast<T>(x[v]) * w[v] + oi;
+        }
+    }
+    return invalid;
+}
+
+} // namespace
+
+HomogeneousTransform composeHomogeneous(std::size_t dim, std::size_t targetDim,
+                                        const double* rotation, ProjectionParams proj,
+                                        const double* scale, const double* offset)
+{
+    const std::size_t n = dim;
+    const std::size_t s = n + 1;
+
+    HomogeneousTransform t;
+    t.dimension       = n;
+    t.targetDimension = targetDim;
+    t.matrix.assign(s * s, 0.0);
+    double* m = t.matrix.data();
+
+    // rotation part; rows past targetDim keep the rotated coordinates
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            m[i * s + j] = rotation ? rotation[i * n + j] : (i == j ? 1.0 : 0.0);
+
+    // projective row: w is a fixed combination of the dropped coordinates
+    double* w = m + n * s;
+    w[n] = 1.0;
+    if (targetDim < n)
+        t.divide = std::visit(ProjectiveFold{ m, n, targetDim }, proj);
+
+    if (scale)
+        for (std::size_t i = 0; i < targetDim; ++i)
+            for (std::size_t j = 0; j < s; ++j)
+                m[i * s + j] *= scale[i];
+    if (offset)
+        for (std::size_t i = 0; i < targetDim; ++i)
+            for (std::size_t j = 0; j < s; ++j)
+                m[i * s + j] += offset[i] * w[j];
+    return t;
+}
+
+const KernelTable& kernelsFor(std::size_t dim)
+{
+    return kernelsFor(dim, detectSimdLevel());
+}
+
+const KernelTable& kernelsFor(std::size_t dim, SimdLevel level)
+{
+    if (dim < kMinKernelDimension || dim > kMaxKernelDimension)
+        return kGenericTable;
+    if (level > detectSimdLevel())
+        level = detectSimdLevel();
+    return allTables()[static_cast<std::size_t>(level)][dim - kMinKernelDimension];
+}
+
+void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                   std::size_t count, double cosA, double sinA)
+{
+    for (std::size_t v = 0; v < count; ++v) {
+        outX[v] = x[v] * cosA - y[v] * sinA;
+        outY[v] = x[v] * sinA + y[v] * cosA;
+    }
+}
+
+std::size_t convertDiagonal(const double* const* columns, double* out, std::size_t count,
+                            std::size_t dim, std::size_t targetDim,
+                            const double* m, const double* offset, bool divide,
+                            unsigned char* valid)
+{
+    return convertDiagonalAs(columns, out, count, dim, targetDim, m, offset, divide, valid,
+                             targetDim);
+}
+
+std::size_t convertDiagonalSingle(const double* const* columns, float* out, std::size_t count,
+                                  std::size_t dim, std::size_t targetDim,
+                                  const float* m, const float* offset, bool divide,
+                                  unsigned char* valid, std::size_t outStride)
+{
+    return convertDiagonalAs(columns, out, count, dim, targetDim, m, offset, divide, valid,
+                             outStride);
+}
@@ -0,0 +1,379 @@
+#ifndef GEOMETRY_KERNELS_H
+#define GEOMETRY_KERNELS_H
+
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Inner loops of the geometry pipeline over flat vertex-major buffers.
+ *
+ * Each kernel processes `count` rows of `dim` doubles (the layout of
+ * NDShape::coordinateData()). Kernels<N> fixes the row width at compile
+ * time so the per-row loops can be unrolled and vectorised; Kernels<0>
+ * is the generic fallback that reads the width from its `dim` argument.
+ * Callers do not use Kernels<N> directly but pick a KernelTable once per
+ * object with kernelsFor().
+ *
+ * Projection kernels report a vanishing denominator by returning false
+ * instead of throwing, so the hot loop stays branch-free; the caller
+ * raises the error.
+ *
+ * The kernels are built without floating-point contraction, so every
+ * instruction set tier rounds identically.
+ */
+
+/// Parameters of the built-in perspective projection.
+struct PerspectiveParams {
+    double distance = 0.0;
+
+    bool operator==(const PerspectiveParams& o) const { return distance == o.distance; }
+    bool operator!=(const PerspectiveParams& o) const { return !(*this == o); }
+};
+
+/// The built-in orthographic projection; it has no parameters.
+struct OrthographicParams {
+    bool operator==(const OrthographicParams&) const { return true; }
+    bool operator!=(const OrthographicParams&) const { return false; }
+};
+
+/// The built-in stereographic projection; it has no parameters.
+struct StereographicParams {
+    bool operator==(const StereographicParams&) const { return true; }
+    bool operator!=(const StereographicParams&) const { return false; }
+};
+
+/**
+ * @brief Closed description of a projection, consumed by composeHomogeneous().
+ *
+ * std::monostate stands for a custom projection that cannot be expressed
+ * in closed form and goes through the staged path instead.
+ */
+using ProjectionParams = std::variant<std::monostate, PerspectiveParams,
+                                      OrthographicParams, StereographicParams>;
+
+/**
+ * @brief An object's whole transform as one (dim+1)×(dim+1) homogeneous matrix.
+ *
+ * Rotation, orthographic truncation, scale and offset are affine. The
+ * cascaded perspective and stereographic projections add one projective
+ * row: projecting coordinates t..n-1 away one at a time equals a single
+ * divide by
+ *   w = d + Σ yⱼ   (perspective, numerators scaled by d)
+ *   w = 1 − Σ yⱼ   (stereographic)
+ * over the rotated coordinates yⱼ being dropped. Scale and offset act
+ * after that divide; in homogeneous form the offset becomes o·w.
+ *
+ * Only the combined w is checked against kMinDenominator. The partial
+ * sums a one-dimension-at-a-time cascade divides by along the way are
+ * not, so a vertex on an intermediate pole gets the finite limit of the
+ * cascade here, where Projection::projectShape() would fail.
+ */
+struct HomogeneousTransform {
+    std::size_t         dimension       = 0;
+    std::size_t         targetDimension = 0;
+    std::vector<double> matrix;           ///< row-major, (dimension+1)²
+    bool                divide = false;   ///< whether the last row is projective
+};
+
+/**
+ * @brief Composes offset · scale · projection · rotation.
+ *
+ * @param rotation Row-major dim×dim matrix, or null for the identity.
+ * @param proj     Built-in projection; only read when targetDim < dim.
+ * @param scale, offset targetDim values each, or null.
+ */
+HomogeneousTransform composeHomogeneous(std::size_t dim, std::size_t targetDim,
+                                        const double* rotation, ProjectionParams proj,
+                                        const double* scale, const double* offset);
+
+/**
+ * @brief Smallest |denominator| a kernel still treats as projectable.
+ *
+ * 1e-12 in double. In float the denominator alone carries a rounding error
+ * of about 1e-7 relative to its terms, so anything under 1e-6 is noise
+ * and the threshold is raised accordingly.
+ */
+template<class T>
+constexpr T kMinDenominator = sizeof(T) < sizeof(double) ? T(1e-6) : T(1e-12);
+
+template<std::size_t N>
+struct Kernels {
+    /// Row width: N, or the runtime dimension for the generic variant.
+    static constexpr std::size_t width(std::size_t dim) { return N ? N : dim; }
+
+    /// y = M·x for one row of n values; x and y must not overlap.
+    static void rowTransform(const double* m, const double* x, double* y, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            double acc = 0.0;
+            for (std::size_t j = 0; j < n; ++j)
+                acc += m[i * n + j] * x[j];
+            y[i] = acc;
+        }
+    }
+
+    /// Perspective step n -> n-1 for one row; @p out may alias @p in.
+    static bool rowPerspective(const double* in, double* out, std::size_t n, double d)
+    {
+        const double den = in[n - 1] + d;
+        const double k = d / den;
+        for (std::size_t i = 0; i + 1 < n; ++i)
+            out[i] = in[i] * k;
+        return std::fabs(den) >= kMinDenominator<double>;
+    }
+
+    /// Stereographic step n -> n-1 for one row; @p out may alias @p in.
+    static bool rowStereographic(const double* in, double* out, std::size_t n)
+    {
+        const double den = 1.0 - in[n - 1];
+        const double k = 1.0 / den;
+        for (std::size_t i = 0; i + 1 < n; ++i)
+            out[i] = in[i] * k;
+        return std::fabs(den) >= kMinDenominator<double>;
+    }
+
+    /// Rotates every row in the (a1, a2) plane.
+    static void rotatePlane(double* rows, std::size_t count, std::size_t dim,
+                            std::size_t a1, std::size_t a2, double cosA, double sinA)
+    {
+        const std::size_t n = width(dim);
+        for (std::size_t v = 0; v < count; ++v, rows += n) {
+            const double x = rows[a1];
+            const double y = rows[a2];
+            rows[a1] = x * cosA - y * sinA;
+            rows[a2] = x * sinA + y * cosA;
+        }
+    }
+
+    /// Replaces every row x by M·x for a row-major dim×dim matrix M.
+    static void transformRows(const double* m, double* rows, std::size_t count, std::size_t dim)
+    {
+        const std::size_t n = width(dim);
+        std::array<double, N ? N : 1> fixed;
+        std::vector<double> dynamic(N ? 0 : n);
+        double* x = N ? fixed.data() : dynamic.data();
+        for (std::size_t v = 0; v < count; ++v, rows += n) {
+            for (std::size_t j = 0; j < n; ++j)
+                x[j] = rows[j];
+            rowTransform(m, x, rows, n);
+        }
+    }
+
+    /// pᵢ = d·xᵢ / (xₙ + d); writes rows of dim - 1 values to @p out.
+    static bool projectPerspective(const double* in, double* out, std::size_t count,
+                                   std::size_t dim, double d)
+    {
+        const std::size_t n = width(dim);
+        bool ok = true;
+        for (std::size_t v = 0; v < count; ++v, in += n, out += n - 1)
+            ok &= rowPerspective(in, out, n, d);
+        return ok;
+    }
+
+    /// Drops the last coordinate of every row.
+    static void projectOrthographic(const double* in, double* out, std::size_t count,
+                                    std::size_t dim)
+    {
+        const std::size_t n = width(dim);
+        for (std::size_t v = 0; v < count; ++v, in += n, out += n - 1)
+            for (std::size_t i = 0; i + 1 < n; ++i)
+                out[i] = in[i];
+    }
+
+    /// pᵢ = xᵢ / (1 - xₙ); writes rows of dim - 1 values to @p out.
+    static bool projectStereographic(const double* in, double* out, std::size_t count,
+                                     std::size_t dim)
+    {
+        const std::size_t n = width(dim);
+        bool ok = true;
+        for (std::size_t v = 0; v < count; ++v, in += n, out += n - 1)
+            ok &= rowStereographic(in, out, n);
+        return ok;
+    }
+
+    /// rows = rows * scale + offset; either pointer may be null to skip that step.
+    static void scaleOffset(double* rows, std::size_t count, std::size_t dim,
+                            const double* scale, const double* offset)
+    {
+        const std::size_t n = width(dim);
+        if (scale)
+            for (std::size_t v = 0; v < count; ++v)
+                for (std::size_t i = 0; i < n; ++i)
+                    rows[v * n + i] *= scale[i];
+        if (offset)
+            for (std::size_t v = 0; v < count; ++v)
+                for (std::size_t i = 0; i < n; ++i)
+                    rows[v * n + i] += offset[i];
+    }
+
+    /// h = r[0..n)·x + r[n]: one row of a homogeneous (n+1)-column matrix, in T.
+    template<class T>
+    static T homogeneousRow(const T* r, const T* x, std::size_t n)
+    {
+        T acc = T(0);
+        for (std::size_t j = 0; j < n; ++j)
+            acc += r[j] * x[j];
+        return acc + r[n];
+    }
+
+    /**
+     * @brief Whole conversion as one homogeneous transform: every row x is
+     *        extended to (x, 1), multiplied by the (dim+1)×(dim+1) matrix
+     *        @p m, and the first @p targetDim results are stored to @p out,
+     *        divided by the last one (w) if @p divide is set.
+     *
+     * Rows targetDim..dim-1 of @p m are not read. A row with |w| below
+     * kMinDenominator is still written (with non-finite values) but flagged 0 in
+     * @p valid, which may be null and otherwise receives one flag per row.
+     *
+     * @return The number of invalid rows.
+     */
+    static std::size_t convertHomogeneous(const double* in, double* out, std::size_t count,
+                                          std::size_t dim, std::size_t targetDim,
+                                          const double* m, bool divide, unsigned char* valid)
+    {
+        return convertHomogeneousAs(in, out, count, dim, targetDim, m, divide, valid, targetDim);
+    }
+
+    /**
+     * @brief convertHomogeneous() in single precision: coordinates are
+     *        rounded to float on load and all arithmetic is done in float.
+     *
+     * Row v is stored at @p out + v·@p outStride, so the results can be
+     * written straight into an interleaved upload buffer; @p outStride is
+     * at least @p targetDim and the floats in between are left untouched.
+     */
+    static std::size_t convertHomogeneousSingle(const double* in, float* out, std::size_t count,
+                                                std::size_t dim, std::size_t targetDim,
+                                                const float* m, bool divide, unsigned char* valid,
+                                                std::size_t outStride)
+    {
+        return convertHomogeneousAs(in, out, count, dim, targetDim, m, divide, valid, outStride);
+    }
+
+private:
+    template<class T>
+    static std::size_t convertHomogeneousAs(const double* in, T* out, std::size_t count,
+                                            std::size_t dim, std::size_t targetDim,
+                                            const T* m, bool divide, unsigned char* valid,
+                                            std::size_t outStride)
+    {
+        const std::size_t n = width(dim);
+        const T* wRow = m + n * (n + 1);
+        std::array<T, N ? N : 1> fixed;
+        std::vector<T> dynamic(N ? 0 : n);
+        T* x = N ? fixed.data() : dynamic.data();
+
+        std::size_t invalid = 0;
+        for (std::size_t v = 0; v < count; ++v, in += n, out += outStride) {
+            for (std::size_t j = 0; j < n; ++j)
+                x[j] = static_cast<T>(in[j]);
+            bool ok = true;
+            if (divide) {
+                const T w = homogeneousRow(wRow, x, n);
+                ok = std::fabs(w) >= kMinDenominator<T>;
+                for (std::size_t i = 0; i < targetDim; ++i)
+                    out[i] = homogeneousRow(m + i * (n + 1), x, n) / w;
+            } else {
+                for (std::size_t i = 0; i < targetDim; ++i)
+                    out[i] = homogeneousRow(m + i * (n + 1), x, n);
+            }
+            invalid += !ok;
+            if (valid)
+                valid[v] = ok;
+        }
+        return invalid;
+    }
+};
+
+/**
+ * @brief Function table of one Kernels<N> instantiation.
+ *
+ * Every entry takes the runtime dimension; the specialised entries ignore it.
+ */
+struct KernelTable {
+    std::size_t dimension;   ///< N of the instantiation, 0 for the generic table
+
+    void (*rotatePlane)(double* rows, std::size_t count, std::size_t dim,
+                        std::size_t a1, std::size_t a2, double cosA, double sinA);
+    void (*transformRows)(const double* m, double* rows, std::size_t count, std::size_t dim);
+    bool (*projectPerspective)(const double* in, double* out, std::size_t count,
+                               std::size_t dim, double d);
+    void (*projectOrthographic)(const double* in, double* out, std::size_t count,
+                                std::size_t dim);
+    bool (*projectStereographic)(const double* in, double* out, std::size_t count,
+                                 std::size_t dim);
+    void (*scaleOffset)(double* rows, std::size_t count, std::size_t dim,
+                        const double* scale, const double* offset);
+    std::size_t (*convertHomogeneous)(const double* in, double* out, std::size_t count,
+                                      std::size_t dim, std::size_t targetDim,
+                                      const double* m, bool divide, unsigned char* valid);
+    std::size_t (*convertHomogeneousSingle)(const double* in, float* out, std::size_t count,
+                                            std::size_t dim, std::size_t targetDim,
+                                            const float* m, bool divide, unsigned char* valid,
+                                            std::size_t outStride);
+    void (*rotateColumns)(const double* x, const double* y, double* outX, double* outY,
+                          std::size_t count, double cosA, double sinA);
+    std::size_t (*convertDiagonal)(const double* const* columns, double* out, std::size_t count,
+                                   std::size_t dim, std::size_t targetDim,
+                                   const double* m, const double* offset, bool divide,
+                                   unsigned char* valid);
+    std::size_t (*convertDiagonalSingle)(const double* const* columns, float* out,
+                                         std::size_t count, std::size_t dim,
+                                         std::size_t targetDim, const float* m,
+                                         const float* offset, bool divide,
+                                         unsigned char* valid, std::size_t outStride);
+};
+
+/// Dimensions with a specialised kernel table (the range offered by the UI).
+constexpr std::size_t kMinKernelDimension = 2;
+constexpr std::size_t kMaxKernelDimension = 20;
+
+/**
+ * @brief Returns the kernel table for rows of @p dim values.
+ *
+ * Dimensions in [kMinKernelDimension, kMaxKernelDimension] get a
+ * specialised table, any other dimension the generic one. On x86 the
+ * specialised tables use the vector kernels of simdKernels.h for the best
+ * instruction set the CPU supports.
+ */
+const KernelTable& kernelsFor(std::size_t dim);
+
+/**
+ * @brief Rotates two columns of a dimension-major buffer in their plane,
+ *        writing the results to @p outX and @p outY.
+ *
+ * This and the two convertDiagonal() functions below are the scalar
+ * references; kernelsFor() tables carry vector versions of all three.
+ */
+void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                   std::size_t count, double cosA, double sinA);
+
+/**
+ * @brief convertHomogeneous() for dimension-major input and a matrix
+ *        composed without rotation (composeHomogeneous() with a null rotation).
+ *
+ * Apart from its projective row and the folded offset such a matrix is
+ * diagonal, so each output is outᵢ = mᵢᵢ·xᵢ·(1/w) + offsetᵢ, where w is 1
+ * unless @p divide is set and otherwise only reads the dropped columns.
+ *
+ * @param columns One pointer per axis to @p count coordinates.
+ * @param offset  The offset folded into @p m, or null.
+ * @return The number of invalid rows, flagged as by convertHomogeneous().
+ */
+std::size_t convertDiagonal(const double* const* columns, double* out, std::size_t count,
+                            std::size_t dim, std::size_t targetDim,
+                            const double* m, const double* offset, bool divide,
+                            unsigned char* valid);
+
+/// convertDiagonal() in single precision, with rows @p outStride floats apart
+/// like Kernels<N>::convertHomogeneousSingle().
+std::size_t convertDiagonalSingle(const double* const* columns, float* out, std::size_t count,
+                                  std::size_t dim, std::size_t targetDim,
+                                  const float* m, const float* offset, bool divide,
+                                  unsigned char* valid, std::size_t outStride);
+
+#endif // GEOMETRY_KERNELS_H
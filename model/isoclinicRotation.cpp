@@ -0,0 +1,83 @@
+#include "isoclinicRotation.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <QString>
+#include <QDebug>
+
+Quaternion Quaternion::normalized() const
+{
+    const double n = std::sqrt(w * w + x * x + y * y + z * z);
+    return { w / n, x / n, y / n, z / n };
+}
+
+IsoclinicPair IsoclinicPair::fromRotator(const Rotator& rotator)
+{
+    std::size_t a = rotator.axis1();
+    std::size_t b = rotator.axis2();
+    if (a >= 4 || b >= 4 || a == b) {
+        QString msg = QString("Rotation plane (%1, %2) is not a plane of 4-D space")
+        .arg(a).arg(b);
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+
+    // rotating (b, a) by θ is rotating (a, b) by -θ
+    double half = 0.5 * rotator.angle();
+    if (a > b) {
+        std::swap(a, b);
+        half = -half;
+    }
+    const double c = std::cos(half);
+    const double s = std::sin(half);
+
+    // unit imaginary u = e_a·e_b of the plane; for a = 0, u = e_b
+    double u[4] = { 0.0, 0.0, 0.0, 0.0 };
+    if (a == 0)
+        u[b] = 1.0;
+    else
+        u[6 - a - b] = (b - a == 1) ? 1.0 : -1.0;   // i·j = k, j·k = i, i·k = -j
+
+    // both halves turn (a, b) the same way and cancel on the complementary plane
+    const double rs = a == 0 ? s : -s;
+    IsoclinicPair pair;
+    pair.left  = { c, s * u[1], s * u[2], s * u[3] };
+    pair.right = { c, rs * u[1], rs * u[2], rs * u[3] };
+    return pair;
+}
+
+IsoclinicPair IsoclinicPair::fromChain(const std::vector<Rotator>& chain)
+{
+    IsoclinicPair pair;
+    for (const Rotator& r : chain) {
+        const IsoclinicPair step = fromRotator(r);
+        pair.left  = step.left * pair.left;
+        pair.right = pair.right * step.right;
+    }
+    pair.left  = pair.left.normalized();
+    pair.right = pair.right.normalized();
+    return pair;
+}
+
+void IsoclinicPair::apply(double* p) const
+{
+    const Quaternion q = left * Quaternion{ p[0], p[1], p[2], p[3] } * right;
+    p[0] = q.w;
+    p[1] = q.x;
+    p[2] = q.y;
+    p[3] = q.z;
+}
+
+std::vector<double> IsoclinicPair::toMatrix() const
+{
+    // column j is the image of the basis vector e_j
+    std::vector<double> matrix(16, 0.0);
+    for (std::size_t j = 0; j < 4; ++j) {
+        double e[4] = { 0.0, 0.0, 0.0, 0.0 };
+        e[j] = 1.0;
+        apply(e);
+        for (std::size_t i = 0; i < 4; ++i)
+            matrix[i * 4 + j] = e[i];
+    }
+    return matrix;
+}
@@ -0,0 +1,64 @@
+#ifndef ISOCLINIC_ROTATION_H
+#define ISOCLINIC_ROTATION_H
+
+#include <vector>
+#include "rotator.h"
+
+/**
+ * @brief Hamilton quaternion w + x·i + y·j + z·k.
+ *
+ * A 4-D point (x₀, x₁, x₂, x₃) is identified with x₀ + x₁·i + x₂·j + x₃·k.
+ */
+struct Quaternion {
+    double w = 1.0;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+
+    Quaternion operator*(const Quaternion& q) const
+    {
+        return { w * q.w - x * q.x - y * q.y - z * q.z,
+                 w * q.x + x * q.w + y * q.z - z * q.y,
+                 w * q.y - x * q.z + y * q.w + z * q.x,
+                 w * q.z + x * q.y - y * q.x + z * q.w };
+    }
+
+    /// Returns this quaternion scaled to unit length.
+    Quaternion normalized() const;
+};
+
+/**
+ * @brief A 4-D rotation as a pair of unit quaternions, p ↦ left · p · right.
+ *
+ * Every rotation of 4-space has this form. A plane rotation by θ splits
+ * into a left and a right isoclinic rotation by θ/2 each, and a chain of
+ * rotations composes by multiplying the quaternions, which keeps the
+ * result orthonormal however long the chain is.
+ */
+struct IsoclinicPair {
+    Quaternion left;
+    Quaternion right;
+
+    /**
+     * @brief The pair for a single Rotator.
+     *
+     * @throws std::invalid_argument If the rotator's axes are not distinct axes below 4.
+     */
+    static IsoclinicPair fromRotator(const Rotator& rotator);
+
+    /**
+     * @brief Composes a chain of rotators, applied first to last.
+     *
+     * @return The identity pair for an empty chain.
+     * @throws std::invalid_argument If any rotator does not fit 4-D.
+     */
+    static IsoclinicPair fromChain(const std::vector<Rotator>& chain);
+
+    /// Applies the rotation to the point (p[0], p[1], p[2], p[3]) in place.
+    void apply(double* p) const;
+
+    /// The equivalent row-major 4×4 matrix, the layout of Rotator::composeChain().
+    std::vector<double> toMatrix() const;
+};
+
+#endif // ISOCLINIC_ROTATION_H
@@ -2,6 +2,7 @@
 #include <QtMath>
 #include <QOpenGLWidget>
 #include <QMatrix4x4>
+#include <algorithm>
 #include <vector>
 #include <cstddef>
 #include <QPainter>
@@ -44,9 +45,11 @@ SceneGeometryManager::~SceneGeometryManager()
     glDeleteVertexArrays(1, &vaoTicks_);
 
     glDeleteBuffers(1, &vboPoints_);
+    glDeleteBuffers(1, &vboSphereMesh_);
     glDeleteVertexArrays(1, &vaoPoints_);
 
     glDeleteBuffers(1, &vboLines_);
+    glDeleteBuffers(1, &vboTubeMesh_);
     glDeleteVertexArrays(1, &vaoLines_);
 
     glDeleteBuffers(1, &vboArrowCone_);
@@ -63,11 +66,16 @@ void SceneGeometryManager::initialize()
     glGenVertexArrays(1, &vaoTicks_);
     glGenBuffers(1, &vboTicks_);
 
-    glGenVertexArrays(1, &vaoPoints_);
-    glGenBuffers(1, &vboPoints_);
+    // points and edges are instanced unit meshes; only the instances change
+    std::vector<VertexData> mesh;
+    unitSphere_ = buildUnitSphere(sphereRings_, sphereSectors_);
+    appendSphere(mesh, sphereRadius_, QVector3D(0, 0, 0), QVector3D());
+    createInstancedVao(vaoPoints_, vboSphereMesh_, vboPoints_, mesh, sphereMeshVertexCount_, 1);
 
-    glGenVertexArrays(1, &vaoLines_);
-    glGenBuffers(1, &vboLines_);
+    mesh.clear();
+    appendCylinderWithCaps(mesh, QVector3D(0, 0, 0), QVector3D(0, 0, 1),
+                           tubeRadius_, tubeSegments_, QVector3D());
+    createInstancedVao(vaoLines_, vboTubeMesh_, vboLines_, mesh, tubeMeshVertexCount_, 2);
 
     glGenVertexArrays(1, &vaoArrowCone_);
     glGenBuffers(1, &vboArrowCone_);
@@ -89,14 +97,15 @@ void SceneGeometryManager::updateGeometry()
         return;
     }
 
-    updatePointsData();
-    updateLinesData();
+    updateObjectsData();
 
     geometryDirty_ = false;
 }
 
 void SceneGeometryManager::renderAll(QOpenGLShaderProgram* program)
 {
+    program->setUniformValue("uInstanceMode", 0);
+
     // Render ticks (lines, no lighting)
     if (ticksVertexCount_ > 0) {
         program->setUniformValue("uApplyLighting", false);
@@ -107,23 +116,26 @@ void SceneGeometryManager::renderAll(QOpenGLShaderProgram* program)
         glBindVertexArray(0);
     }
 
-    // Render scene lines (triangles, with lighting)
-    if (linesVertexCount_ > 0) {
+    // Render scene lines (one tube per edge, with lighting)
+    if (linesInstanceCount_ > 0) {
         program->setUniformValue("uApplyLighting", true);
         program->setUniformValue("uApplyShadow", true);
+        program->setUniformValue("uInstanceMode", 2);
         glBindVertexArray(vaoLines_);
-        glDrawArrays(GL_TRIANGLES, 0, linesVertexCount_);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, tubeMeshVertexCount_, linesInstanceCount_);
         glBindVertexArray(0);
     }
 
-    // Render points (small spheres, with lighting)
-    if (pointsVertexCount_ > 0) {
+    // Render points (one small sphere per vertex, with lighting)
+    if (pointsInstanceCount_ > 0) {
         program->setUniformValue("uApplyLighting", true);
         program->setUniformValue("uApplyShadow", true);
+        program->setUniformValue("uInstanceMode", 1);
         glBindVertexArray(vaoPoints_);
-        glDrawArrays(GL_TRIANGLES, 0, pointsVertexCount_);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, sphereMeshVertexCount_, pointsInstanceCount_);
         glBindVertexArray(0);
     }
+    program->setUniformValue("uInstanceMode", 0);
 
     // Render axes (lines, no lighting)
     if (axesVertexCount_ > 0) {
@@ -238,98 +250,129 @@ void SceneGeometryManager::updateTicksData()
                          ticksVertexCount_);
 }
 
-void SceneGeometryManager::updatePointsData()
+void SceneGeometryManager::updateObjectsData()
 {
     auto scenePtr = scene_.lock();
     auto colorPtr = colorificator_.lock();
     if (!scenePtr || !colorPtr) {
-        pointsVertexCount_ = 0;
+        pointsInstanceCount_ = 0;
+        linesInstanceCount_  = 0;
         return;
     }
 
-    auto vBegin = colorPtr->beginVertices(*scenePtr);
-    auto vEnd   = colorPtr->endVertices(*scenePtr);
-
-    std::vector<VertexData> sphereTriangles;
-
-    for (auto it = vBegin; it != vEnd; ++it) {
-        auto cv = *it;
-        QVector3D pos(0,0,0);
-
-        if (!cv.coords.empty())   pos.setX(cv.coords[0]);
-        if (cv.coords.size() > 1) pos.setY(cv.coords[1]);
-        if (cv.coords.size() > 2) pos.setZ(cv.coords[2]);
+    std::vector<std::shared_ptr<SceneObject>> objects;
+    std::size_t vertexCount = 0;
+    for (const auto& weakObj : scenePtr->getAllObjects()) {
+        if (auto obj = weakObj.lock()) {
+            vertexCount += obj->shape->vertexIds().size();
+            objects.push_back(std::move(obj));
+        }
+    }
 
-        QVector3D col(cv.color.redF(),
-                      cv.color.greenF(),
-                      cv.color.blueF());
+    // The conversion kernels write every position straight into the point
+    // instances; the staging vectors keep their capacity between updates.
+    pointInstances_.resize(vertexCount * kPointStride);
+    lineInstances_.clear();
+
+    const int sceneDimension = static_cast<int>(scenePtr->getSceneDimension());
+    std::size_t first = 0;   // first row of the current object
+    std::size_t kept  = 0;   // point instances written so far
+    for (const auto& obj : objects) {
+        float* rows = pointInstances_.data() + first * kPointStride;
+        const ConvertedData conv = Scene::convertObject(*obj, sceneDimension,
+                                                        scenePtr->conversionOptions(),
+                                                        rows, kPointStride);
+
+        const QColor color = colorPtr->getColorForObject(obj->uid);
+        const float rgb[3] = { float(color.redF()), float(color.greenF()), float(color.blueF()) };
+
+        for (const auto& edge : conv.edges) {
+            const std::size_t ra = conv.rowOf(edge.first);
+            const std::size_t rb = conv.rowOf(edge.second);
+            // convertObject() already drops these edges; never draw to a masked row
+            if (!conv.isValid(ra) || !conv.isValid(rb))
+                continue;
+            const float* a = rows + ra * kPointStride;
+            const float* b = rows + rb * kPointStride;
+            lineInstances_.insert(lineInstances_.end(),
+                                  { a[0], a[1], a[2], b[0], b[1], b[2], rgb[0], rgb[1], rgb[2] });
+        }
 
-        // Build a small sphere
-        auto sphereVerts = buildSphere(sphereRadius_,
-                                       sphereRings_,
-                                       sphereSectors_,
-                                       pos,
-                                       col);
-        sphereTriangles.insert(sphereTriangles.end(),
-                               sphereVerts.begin(),
-                               sphereVerts.end());
+        // colour the valid rows, closing the gaps left by invalid ones
+        for (std::size_t k = 0; k < conv.vertexCount(); ++k) {
+            if (!conv.isValid(k))
+                continue;
+            float* dst = pointInstances_.data() + kept * kPointStride;
+            const float* src = rows + k * kPointStride;
+            if (dst != src)
+                std::copy(src, src + 3, dst);
+            std::copy(rgb, rgb + 3, dst + 3);
+            ++kept;
+        }
+        first += conv.vertexCount();
     }
 
     // Upload
-    createOrUpdateBuffer(vaoPoints_, vboPoints_,
-                         sphereTriangles.data(),
-                         sphereTriangles.size() * sizeof(VertexData),
-                         pointsVertexCount_);
+    uploadInstances(vboPoints_, pointInstances_.data(), kept, kPointStride, pointsInstanceCount_);
+    uploadInstances(vboLines_, lineInstances_.data(), lineInstances_.size() / kLineStride,
+                    kLineStride, linesInstanceCount_);
 }
 
-void SceneGeometryManager::updateLinesData()
+void SceneGeometryManager::createInstancedVao(GLuint &vao,
+                                              GLuint &meshVbo,
+                                              GLuint &instanceVbo,
+                                              const std::vector<VertexData>& mesh,
+                                              GLsizei &meshVertexCount,
+                                              int instancePositions)
 {
-    auto scenePtr = scene_.lock();
-    auto colorPtr = colorificator_.lock();
-    if (!scenePtr || !colorPtr) {
-        linesVertexCount_ = 0;
-        return;
-    }
-
-    auto eBegin = colorPtr->beginEdges(*scenePtr);
-    auto eEnd   = colorPtr->endEdges(*scenePtr);
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &meshVbo);
+    glGenBuffers(1, &instanceVbo);
 
-    std::vector<VertexData> allCylinders;
-
-    for (auto it = eBegin; it != eEnd; ++it) {
-        auto cl = *it;
-
-        QVector3D start(0,0,0), end(0,0,0);
-        if (!cl.start.empty()) {
-            start.setX(cl.start[0]);
-            if (cl.start.size() > 1) start.setY(cl.start[1]);
-            if (cl.start.size() > 2) start.setZ(cl.start[2]);
-        }
-        if (!cl.end.empty()) {
-            end.setX(cl.end[0]);
-            if (cl.end.size() > 1) end.setY(cl.end[1]);
-            if (cl.end.size() > 2) end.setZ(cl.end[2]);
-        }
+    glBindVertexArray(vao);
 
-        QVector3D col(cl.color.redF(),
-                      cl.color.greenF(),
-                      cl.color.blueF());
-
-        // Build a cylinder
-        auto cylVerts = buildCylinderWithCaps(start,
-                                              end,
-                                              tubeRadius_,
-                                              tubeSegments_,
-                                              col);
-        allCylinders.insert(allCylinders.end(),
-                            cylVerts.begin(),
-                            cylVerts.end());
+    // Mesh position => location 0, normal => location 1
+    glBindBuffer(GL_ARRAY_BUFFER, meshVbo);
+    glBufferData(GL_ARRAY_BUFFER, mesh.size() * sizeof(VertexData), mesh.data(), GL_STATIC_DRAW);
+    meshVertexCount = static_cast<GLsizei>(mesh.size());
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
+                          sizeof(VertexData),
+                          reinterpret_cast<void*>(offsetof(VertexData, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
+                          sizeof(VertexData),
+                          reinterpret_cast<void*>(offsetof(VertexData, normal)));
+
+    // Per instance: positions => locations 3.., then the color => location 2
+    const GLsizei stride = static_cast<GLsizei>((instancePositions + 1) * 3 * sizeof(float));
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    for (int i = 0; i < instancePositions; ++i) {
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribPointer(3 + i, 3, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<void*>(i * 3 * sizeof(float)));
+        glVertexAttribDivisor(3 + i, 1);
     }
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void*>(instancePositions * 3 * sizeof(float)));
+    glVertexAttribDivisor(2, 1);
 
-    createOrUpdateBuffer(vaoLines_, vboLines_,
-                         allCylinders.data(),
-                         allCylinders.size() * sizeof(VertexData),
-                         linesVertexCount_);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void SceneGeometryManager::uploadInstances(GLuint vbo,
+                                           const float* data,
+                                           std::size_t instances,
+                                           std::size_t stride,
+                                           GLsizei &instanceCount)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, instances * stride * sizeof(float),
+                 instances ? data : nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    instanceCount = static_cast<GLsizei>(instances);
 }
 
 void SceneGeometryManager::createOrUpdateBuffer(GLuint &vao,
@@ -469,15 +512,10 @@ bool SceneGeometryManager::isGeometryDirty(){
     return geometryDirty_;
 }
 
-std::vector<SceneGeometryManager::VertexData>
-SceneGeometryManager::buildSphere(float radius,
-                                  int rings,
-                                  int sectors,
-                                  const QVector3D& center,
-                                  const QVector3D& color)
+std::vector<QVector3D> SceneGeometryManager::buildUnitSphere(int rings, int sectors)
 {
-    std::vector<VertexData> vertices;
-    vertices.reserve(rings * sectors * 6);
+    std::vector<QVector3D> directions;
+    directions.reserve(rings * sectors * 6);
 
     for (int r = 0; r < rings; ++r) {
         float theta1 = float(M_PI) * float(r)       / rings;
@@ -500,42 +538,39 @@ SceneGeometryManager::buildSphere(float radius,
                          std::cos(theta2),
                          std::sin(theta2) * std::sin(phi2));
 
-            p1 = p1 * radius + center;
-            p2 = p2 * radius + center;
-            p3 = p3 * radius + center;
-            p4 = p4 * radius + center;
+            directions.push_back(p1.normalized());
+            directions.push_back(p2.normalized());
+            directions.push_back(p3.normalized());
 
-            QVector3D n1 = (p1 - center).normalized();
-            QVector3D n2 = (p2 - center).normalized();
-            QVector3D n3 = (p3 - center).normalized();
-            QVector3D n4 = (p4 - center).normalized();
-
-            vertices.push_back({ p1, n1, color });
-            vertices.push_back({ p2, n2, color });
-            vertices.push_back({ p3, n3, color });
-
-            vertices.push_back({ p2, n2, color });
-            vertices.push_back({ p4, n4, color });
-            vertices.push_back({ p3, n3, color });
+            directions.push_back(p2.normalized());
+            directions.push_back(p4.normalized());
+            directions.push_back(p3.normalized());
         }
     }
-    return vertices;
+    return directions;
 }
 
-std::vector<SceneGeometryManager::VertexData>
-SceneGeometryManager::buildCylinderWithCaps(const QVector3D& start,
-                                            const QVector3D& end,
-                                            float radius,
-                                            int segments,
-                                            const QVector3D& color)
+void SceneGeometryManager::appendSphere(std::vector<VertexData>& out,
+                                        float radius,
+                                        const QVector3D& center,
+                                        const QVector3D& color) const
 {
-    std::vector<VertexData> verts;
-    verts.reserve(segments * 12); // sides + caps
+    // the unit directions double as the normals
+    for (const QVector3D& n : unitSphere_)
+        out.push_back({ center + n * radius, n, color });
+}
 
+void SceneGeometryManager::appendCylinderWithCaps(std::vector<VertexData>& verts,
+                                                  const QVector3D& start,
+                                                  const QVector3D& end,
+                                                  float radius,
+                                                  int segments,
+                                                  const QVector3D& color)
+{
     QVector3D axis = end - start;
     float height = axis.length();
     if (height < 1e-6f) {
-        return verts; // degenerate
+        return; // degenerate
     }
 
     QVector3D axisDir = axis.normalized();
@@ -546,7 +581,11 @@ SceneGeometryManager::buildCylinderWithCaps(const QVector3D& start,
     QVector3D perpX = QVector3D::crossProduct(axisDir, up).normalized();
     QVector3D perpY = QVector3D::crossProduct(axisDir, perpX).normalized();
 
-    std::vector<QVector3D> ringStart(segments), ringEnd(segments);
+    // scratch rings are members, so no allocation per edge
+    ringStart_.resize(segments);
+    ringEnd_.resize(segments);
+    std::vector<QVector3D>& ringStart = ringStart_;
+    std::vector<QVector3D>& ringEnd   = ringEnd_;
     for (int i = 0; i < segments; ++i) {
         float theta = 2.0f * float(M_PI) * float(i) / float(segments);
         float x = radius * std::cos(theta);
@@ -615,8 +654,6 @@ SceneGeometryManager::buildCylinderWithCaps(const QVector3D& start,
             verts.push_back({ end, topNormal, color });
         }
     }
-
-    return verts;
 }
 
 std::vector<SceneGeometryManager::VertexData>
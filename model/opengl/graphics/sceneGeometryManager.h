@@ -109,11 +109,36 @@ private:
                               size_t dataSize,
                               GLsizei &vertexCount);
 
+    /**
+     * @brief Creates a VAO drawing `mesh` once per instance. Each instance
+     *        holds `instancePositions` float3 positions (locations 3, 4)
+     *        followed by a float3 colour (location 2).
+     */
+    void createInstancedVao(GLuint &vao,
+                            GLuint &meshVbo,
+                            GLuint &instanceVbo,
+                            const std::vector<VertexData>& mesh,
+                            GLsizei &meshVertexCount,
+                            int instancePositions);
+
+    /**
+     * @brief Uploads `instances` rows of `stride` floats to an instance VBO.
+     */
+    void uploadInstances(GLuint vbo,
+                         const float* data,
+                         std::size_t instances,
+                         std::size_t stride,
+                         GLsizei &instanceCount);
+
     // Geometry update helpers
     void updateAxesData();
     void updateTicksData();
-    void updatePointsData();
-    void updateLinesData();
+
+    /**
+     * @brief Converts every scene object straight into the point instances
+     *        and gathers the edge instances from them.
+     */
+    void updateObjectsData();
 
     // Overlay methods
 
@@ -127,22 +152,29 @@ private:
     // Internal geometry-building methods
 
     /**
-     * @brief Builds a UV-sphere mesh of radius `radius` with the given rings & sectors.
+     * @brief Builds the triangle list of a unit UV-sphere with the given rings & sectors.
+     */
+    static std::vector<QVector3D> buildUnitSphere(int rings, int sectors);
+
+    /**
+     * @brief Appends the cached unit sphere, scaled to `radius` and moved to `center`, to `out`.
+     *        Builds the instanced sphere mesh.
      */
-    std::vector<VertexData> buildSphere(float radius,
-                                        int rings,
-                                        int sectors,
-                                        const QVector3D& center,
-                                        const QVector3D& color);
+    void appendSphere(std::vector<VertexData>& out,
+                      float radius,
+                      const QVector3D& center,
+                      const QVector3D& color) const;
 
     /**
-     * @brief Builds a closed cylinder from `start` to `end` with radius `radius`.
+     * @brief Appends a closed cylinder from `start` to `end` with radius `radius` to `out`.
+     *        Builds the instanced tube mesh, which the vertex shader stretches per edge.
      */
-    std::vector<VertexData> buildCylinderWithCaps(const QVector3D& start,
-                                                  const QVector3D& end,
-                                                  float radius,
-                                                  int segments,
-                                                  const QVector3D& color);
+    void appendCylinderWithCaps(std::vector<VertexData>& out,
+                                const QVector3D& start,
+                                const QVector3D& end,
+                                float radius,
+                                int segments,
+                                const QVector3D& color);
 
     /**
      * @brief Builds a cone with a circular base.
@@ -165,17 +197,27 @@ private:
     // VAOs / VBOs
     GLuint vaoAxes_ = 0,   vboAxes_ = 0;
     GLuint vaoTicks_ = 0,  vboTicks_ = 0;
-    GLuint vaoPoints_ = 0, vboPoints_ = 0;
-    GLuint vaoLines_ = 0,  vboLines_ = 0;
+    GLuint vaoPoints_ = 0, vboPoints_ = 0, vboSphereMesh_ = 0;   // vboPoints_ holds the instances
+    GLuint vaoLines_ = 0,  vboLines_ = 0,  vboTubeMesh_ = 0;     // vboLines_ holds the instances
     GLuint vaoArrowCone_ = 0, vboArrowCone_ = 0;
 
     // Vertex counts
     GLsizei axesVertexCount_ = 0;
     GLsizei ticksVertexCount_ = 0;
-    GLsizei pointsVertexCount_ = 0;
-    GLsizei linesVertexCount_ = 0;
+    GLsizei pointsInstanceCount_ = 0;
+    GLsizei linesInstanceCount_ = 0;
+    GLsizei sphereMeshVertexCount_ = 0;
+    GLsizei tubeMeshVertexCount_ = 0;
     GLsizei arrowConeVertexCount_ = 0;
 
+    // Refresh-path staging, reused between updates
+    static constexpr std::size_t kPointStride = 6;   ///< centre, colour
+    static constexpr std::size_t kLineStride  = 9;   ///< start, end, colour
+    std::vector<float>      pointInstances_;
+    std::vector<float>      lineInstances_;
+    std::vector<QVector3D>  unitSphere_;      ///< built in initialize()
+    std::vector<QVector3D>  ringStart_, ringEnd_;
+
     // Configurable geometry parameters
     float lineWidthThin_ = 2.0f;
     float tickOffset_ = 0.1f;
@@ -0,0 +1,183 @@
+#include "parallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QRunnable>
+#include <QThreadPool>
+
+namespace {
+/// State shared by the caller and the helper tasks; outlives the call if a
+/// helper only starts after all work is done.
+struct ForState {
+    std::size_t                        count = 0;
+    std::function<void(std::size_t)>   body;
+    std::atomic<std::size_t>           next{0};
+    std::atomic<bool>                  failed{false};
+
+    std::mutex                         mutex;
+    std::condition_variable            idle;
+    int                                running = 0;   ///< threads inside work()
+    std::exception_ptr                 error;
+
+    void work()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++running;
+        }
+        for (std::size_t i = next++; i < count && !failed; i = next++) {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0)
+            idle.notify_all();
+    }
+};
+
+class ForTask : public QRunnable {
+public:
+    explicit ForTask(std::shared_ptr<ForState> state) : state_(std::move(state)) {}
+    void run() override
+    {
+        // nothing left to claim: do not register as running
+        if (state_->next.load() < state_->count && !state_->failed)
+            state_->work();
+    }
+
+private:
+    std::shared_ptr<ForState> state_;
+};
+} // namespace
+
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body, int maxThreads)
+{
+    QThreadPool* pool = QThreadPool::globalInstance();
+    if (maxThreads <= 0)
+        maxThreads = pool->maxThreadCount();
+
+    if (count <= 1 || maxThreads <= 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            body(i);
+        return;
+    }
+
+    auto state   = std::make_shared<ForState>();
+    state->count = count;
+    state->body  = body;
+
+    const std::size_t helpers = std::min<std::size_t>(count, std::size_t(maxThreads)) - 1;
+    for (std::size_t t = 0; t < helpers; ++t)
+        pool->start(new ForTask(state));
+
+    state->work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->idle.wait(lock, [&] { return state->running == 0; });
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+namespace {
+/// One thread's share of a parallelForRange(): [lo, hi), taken from the front
+/// by its owner and from the back by thieves.
+struct Span {
+    std::mutex  mutex;
+    std::size_t lo = 0;
+    std::size_t hi = 0;
+
+    bool popFront(std::size_t grain, std::size_t& b, std::size_t& e)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (lo >= hi) return false;
+        b  = lo;
+        e  = std::min(hi, lo + grain);
+        lo = e;
+        return true;
+    }
+
+    std::size_t remaining()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hi - lo;
+    }
+
+    /// Gives away the back half (everything if at most one grain is left).
+    bool stealBack(std::size_t grain, std::size_t& b, std::size_t& e)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::size_t left = hi - lo;
+        if (left == 0) return false;
+        const std::size_t mid = left <= grain ? lo : lo + left / 2;
+        b  = mid;
+        e  = hi;
+        hi = mid;
+        return true;
+    }
+
+    void reset(std::size_t b, std::size_t e)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        lo = b;
+        hi = e;
+    }
+};
+} // namespace
+
+void parallelForRange(std::size_t begin, std::size_t end, std::size_t grain,
+                      const std::function<void(std::size_t, std::size_t)>& body,
+                      int maxThreads)
+{
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+    if (maxThreads <= 0)
+        maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+
+    const std::size_t total   = end - begin;
+    const std::size_t chunks  = (total + grain - 1) / grain;
+    const std::size_t threads = std::min<std::size_t>(chunks, std::size_t(std::max(maxThreads, 1)));
+    if (threads <= 1) {
+        for (std::size_t b = begin; b < end; b += grain)
+            body(b, std::min(end, b + grain));
+        return;
+    }
+
+    std::vector<Span> spans(threads);
+    for (std::size_t t = 0; t < threads; ++t)
+        spans[t].reset(begin + total * t / threads, begin + total * (t + 1) / threads);
+
+    std::atomic<bool> stop{false};
+    parallelFor(threads, [&](std::size_t self) {
+        std::size_t b, e;
+        while (!stop) {
+            if (!spans[self].popFront(grain, b, e)) {
+                // pick the victim with the most work left
+                std::size_t victim = threads, most = 0;
+                for (std::size_t t = 0; t < threads; ++t) {
+                    const std::size_t left = t == self ? 0 : spans[t].remaining();
+                    if (left > most) { most = left; victim = t; }
+                }
+                if (victim == threads)
+                    break;   // nothing left anywhere
+                if (spans[victim].stealBack(grain, b, e))
+                    spans[self].reset(b, e);
+                continue;
+            }
+            try {
+                body(b, e);
+            } catch (...) {
+                stop = true;
+                throw;
+            }
+        }
+    }, int(threads));
+}
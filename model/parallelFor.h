@@ -0,0 +1,39 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Runs body(i) for every i in [0, count) on the global QThreadPool.
+ *
+ * Items are claimed in ascending order from a shared counter, so callers
+ * that sort their items by decreasing cost get longest-first scheduling.
+ * The calling thread processes items as well and returns once all of them
+ * are done. Nested calls from pool threads are therefore safe: if no pool
+ * thread is free, the caller does all the work itself.
+ *
+ * If a body throws, items not yet claimed are skipped, and the first
+ * exception is rethrown in the caller once every running body has returned.
+ *
+ * @param maxThreads Upper bound on threads, the caller included; 0 means
+ *                   the pool's maxThreadCount().
+ */
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body,
+                 int maxThreads = 0);
+
+/**
+ * @brief Runs body(b, e) over chunks of [begin, end) of at most @p grain
+ *        indices, with work stealing.
+ *
+ * The range starts out split evenly between the threads. Each thread takes
+ * chunks from the front of its own part. A thread that runs dry steals the
+ * back half of the largest remaining part, so uneven chunks still balance.
+ * Every index is covered by exactly one call. Threads, nesting and
+ * exceptions behave as in parallelFor().
+ */
+void parallelForRange(std::size_t begin, std::size_t end, std::size_t grain,
+                      const std::function<void(std::size_t, std::size_t)>& body,
+                      int maxThreads = 0);
+
+#endif // PARALLEL_FOR_H
@@ -1,7 +1,56 @@
 #include "projection.h"
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <variant>
 #include <QDebug>
+#include "geometryKernels.h"
+
+namespace {
+void requireProjectableDimension(std::size_t dim, const char* projectionName)
+{
+    if (dim <= 1) {
+        QString msg = QString("Point dimension must be > 1 for %1.").arg(projectionName);
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+}
+
+void throwDivisionByZero(const char* projectionName)
+{
+    QString msg = QString("Division by zero in %1.").arg(projectionName);
+    qWarning() << msg;
+    throw std::runtime_error(msg.toStdString());
+}
+} // namespace
+
+const char* projectionName(const ProjectionParams& params)
+{
+    struct Name {
+        const char* operator()(std::monostate) const             { return "Projection"; }
+        const char* operator()(const PerspectiveParams&) const   { return "PerspectiveProjection"; }
+        const char* operator()(const OrthographicParams&) const  { return "OrthographicProjection"; }
+        const char* operator()(const StereographicParams&) const { return "StereographicProjection"; }
+    };
+    return std::visit(Name{}, params);
+}
+
+std::shared_ptr<Projection> makeProjection(const ProjectionParams& params)
+{
+    struct Make {
+        std::shared_ptr<Projection> operator()(std::monostate) const { return nullptr; }
+        std::shared_ptr<Projection> operator()(const PerspectiveParams& p) const {
+            return std::make_shared<PerspectiveProjection>(p.distance);
+        }
+        std::shared_ptr<Projection> operator()(const OrthographicParams&) const {
+            return std::make_shared<OrthographicProjection>();
+        }
+        std::shared_ptr<Projection> operator()(const StereographicParams&) const {
+            return std::make_shared<StereographicProjection>();
+        }
+    };
+    return std::visit(Make{}, params);
+}
 
 NDShape Projection::projectShape(const NDShape& shape) const {
     std::size_t oldDim = shape.getDimension();
@@ -13,14 +62,18 @@ NDShape Projection::projectShape(const NDShape& shape) const {
 
     NDShape newShape = shape.clone(oldDim - 1);
 
-    auto allVertices = shape.getAllVertices();
-    for (const auto& [vertexId, coords] : allVertices) {
-        std::vector<double> projectedCoords = projectPoint(coords);
-        newShape.setVertexCoords(vertexId, projectedCoords);
-    }
+    // Rows of both shapes share the same (ascending ID) order.
+    projectPoints(shape.coordinateData(), shape.vertexIds().size(), oldDim,
+                  newShape.coordinateData());
     return newShape;
 }
 
+std::vector<double> Projection::projectPoint(const std::vector<double>& point) const {
+    std::vector<double> result(point.size() > 1 ? point.size() - 1 : 0);
+    projectPoints(point.data(), 1, point.size(), result.data());
+    return result;
+}
+
 NDShape Projection::projectShapeToDimension(const NDShape& shape, std::size_t targetDim) const {
     if (targetDim == 0) {
         QString msg = "Target dimension cannot be zero.";
@@ -33,11 +86,31 @@ NDShape Projection::projectShapeToDimension(const NDShape& shape, std::size_t ta
         return shape;
     }
 
-    NDShape tmp = shape;
-    while (tmp.getDimension() > targetDim) {
-        tmp = projectShape(tmp);
+    // The result shares the topology of the source; only one coordinate
+    // buffer is allocated for the whole cascade.
+    NDShape result = shape.clone(targetDim);
+    const std::size_t count = shape.vertexIds().size();
+
+    const ProjectionParams params = kernelParams();
+    if (!std::holds_alternative<std::monostate>(params)) {
+        const HomogeneousTransform t = composeHomogeneous(currentDim, targetDim, nullptr, params,
+                                                          nullptr, nullptr);
+        if (kernelsFor(currentDim).convertHomogeneous(shape.coordinateData(), result.coordinateData(),
+                                                      count, currentDim, targetDim,
+                                                      t.matrix.data(), t.divide, nullptr) != 0)
+            throwDivisionByZero(projectionName(params));
+        return result;
     }
-    return tmp;
+
+    // Custom projections step through projectPoints() between two scratch buffers.
+    std::vector<double> from(shape.coordinateData(), shape.coordinateData() + count * currentDim);
+    std::vector<double> to(count * (currentDim - 1));
+    for (std::size_t dim = currentDim; dim > targetDim; --dim) {
+        projectPoints(from.data(), count, dim, to.data());
+        std::swap(from, to);
+    }
+    std::copy(from.begin(), from.begin() + count * targetDim, result.coordinateData());
+    return result;
 }
 
 // PerspectiveProjection
@@ -46,25 +119,11 @@ PerspectiveProjection::PerspectiveProjection(double distance)
 {
 }
 
-std::vector<double> PerspectiveProjection::projectPoint(const std::vector<double>& point) const {
-    std::size_t n = point.size();
-    if (n <= 1) {
-        QString msg = "Point dimension must be > 1 for PerspectiveProjection.";
-        qWarning() << msg;
-        throw std::invalid_argument(msg.toStdString());
-    }
-
-    double denominator = point[n - 1] + d_;
-    if (std::fabs(denominator) < 1e-12) {
-        QString msg = "Division by zero in PerspectiveProjection.";
-        qWarning() << msg;
-        throw std::runtime_error(msg.toStdString());
-    }
-    std::vector<double> result(n - 1);
-    for (std::size_t i = 0; i < n - 1; ++i) {
-        result[i] = (d_ * point[i]) / denominator;
-    }
-    return result;
+void PerspectiveProjection::projectPoints(const double* in, std::size_t count, std::size_t dim,
+                                          double* out) const {
+    requireProjectableDimension(dim, "PerspectiveProjection");
+    if (!kernelsFor(dim).projectPerspective(in, out, count, dim, d_))
+        throwDivisionByZero("PerspectiveProjection");
 }
 
 std::shared_ptr<Projection> PerspectiveProjection::clone() const {
@@ -72,15 +131,10 @@ std::shared_ptr<Projection> PerspectiveProjection::clone() const {
 }
 
 // OrthographicProjection
-std::vector<double> OrthographicProjection::projectPoint(const std::vector<double>& point) const {
-    std::size_t n = point.size();
-    if (n <= 1) {
-        QString msg = "Point dimension must be > 1 for OrthographicProjection.";
-        qWarning() << msg;
-        throw std::invalid_argument(msg.toStdString());
-    }
-
-    return std::vector<double>(point.begin(), point.end() - 1);
+void OrthographicProjection::projectPoints(const double* in, std::size_t count, std::size_t dim,
+                                           double* out) const {
+    requireProjectableDimension(dim, "OrthographicProjection");
+    kernelsFor(dim).projectOrthographic(in, out, count, dim);
 }
 
 std::shared_ptr<Projection> OrthographicProjection::clone() const {
@@ -88,28 +142,13 @@ std::shared_ptr<Projection> OrthographicProjection::clone() const {
 }
 
 // StereographicProjection
-std::vector<double> StereographicProjection::projectPoint(const std::vector<double>& point) const {
-    std::size_t n = point.size();
-    if (n <= 1) {
-        QString msg = "Point dimension must be > 1 for StereographicProjection.";
-        qWarning() << msg;
-        throw std::invalid_argument(msg.toStdString());
-    }
-
-    double denominator = 1.0 - point[n - 1];
-    if (std::fabs(denominator) < 1e-12) {
-        QString msg = "Division by zero in StereographicProjection.";
-        qWarning() << msg;
-        throw std::runtime_error(msg.toStdString());
-    }
-    std::vector<double> result(n - 1);
-    for (std::size_t i = 0; i < n - 1; ++i) {
-        result[i] = point[i] / denominator;
-    }
-    return result;
+void StereographicProjection::projectPoints(const double* in, std::size_t count, std::size_t dim,
+                                            double* out) const {
+    requireProjectableDimension(dim, "StereographicProjection");
+    if (!kernelsFor(dim).projectStereographic(in, out, count, dim))
+        throwDivisionByZero("StereographicProjection");
 }
 
-
 std::shared_ptr<Projection> StereographicProjection::clone() const {
     return std::make_shared<StereographicProjection>(*this);
 }
@@ -2,6 +2,7 @@
 #define PROJECTION_H
 
 #include "NDShape.h"
+#include "geometryKernels.h"
 #include <memory>
 #include <vector>
 
@@ -15,14 +16,41 @@ public:
 
     /**
      * @brief Projects a single n-dimensional point to (n-1) dimensions.
+     *
+     * Thin wrapper over projectPoints() for one point.
+     *
      * @param point The n-dimensional point.
      * @return The projected (n-1)-dimensional point.
      * @throws std::invalid_argument If point.size() <= 1.
+     * @throws std::runtime_error If the point cannot be projected.
+     */
+    std::vector<double> projectPoint(const std::vector<double>& point) const;
+
+    /**
+     * @brief Projects @p count points stored as flat rows of @p dim values
+     *        into rows of dim - 1 values at @p out.
+     *
+     * @p in and @p out use the layout of NDShape::coordinateData() and must
+     * not overlap.
+     *
+     * @throws std::invalid_argument If dim <= 1.
+     * @throws std::runtime_error If a point cannot be projected.
+     */
+    virtual void projectPoints(const double* in, std::size_t count, std::size_t dim,
+                               double* out) const = 0;
+
+    /**
+     * @brief Describes this projection for the fused conversion kernel.
+     *
+     * Projections that cannot be expressed as ProjectionParams keep the
+     * default (std::monostate) and are converted step by step through
+     * projectPoints(). The closed alternatives also let callers such as the
+     * serializer inspect a projection without RTTI.
      */
-    virtual std::vector<double> projectPoint(const std::vector<double>& point) const = 0;
+    virtual ProjectionParams kernelParams() const { return {}; }
 
     /**
-     * @brief Projects the entire NDShape from dimension n to (n-1) using projectPoint().
+     * @brief Projects the entire NDShape from dimension n to (n-1) using projectPoints().
      *
      * @param shape The NDShape to project.
      * @return A new NDShape with dimension = shape.getDimension() - 1.
@@ -31,7 +59,14 @@ public:
     NDShape projectShape(const NDShape& shape) const;
 
     /**
-     * @brief Iteratively projects the given NDShape until it reaches the specified target dimension.
+     * @brief Projects the given NDShape down to the specified target dimension.
+     *
+     * Built-in projections evaluate the whole cascade per vertex in one pass
+     * as a single homogeneous transform (see composeHomogeneous()); the edges
+     * are shared with @p shape rather than copied. This agrees with repeated
+     * projectShape() up to rounding, but only the combined denominator is
+     * checked: a vertex on the pole of an intermediate step is projected to
+     * the finite limit instead of throwing.
      *
      * @param shape The NDShape to reduce.
      * @param targetDim The dimension to stop at. Must be >= 1.
@@ -60,16 +95,18 @@ public:
     explicit PerspectiveProjection(double distance);
 
     /**
-     * @brief Implements projectPoint for perspective projection.
-     * @param point The n-dimensional point.
-     * @return The (n-1)-dimensional result.
-     * @throws std::runtime_error If the denominator (xₙ + d) is zero or extremely close to zero.
+     * @brief Implements projectPoints for perspective projection.
+     * @throws std::runtime_error If some denominator (xₙ + d) is zero or extremely close to zero.
      */
-    std::vector<double> projectPoint(const std::vector<double>& point) const override;
+    void projectPoints(const double* in, std::size_t count, std::size_t dim,
+                       double* out) const override;
+    ProjectionParams kernelParams() const override {
+        return PerspectiveParams{ d_ };
+    }
 
     std::shared_ptr<Projection> clone() const override;
 
-    const double getDistance(){ return d_; }
+    double getDistance() const { return d_; }
 
 
 private:
@@ -82,7 +119,11 @@ private:
 class OrthographicProjection : public Projection {
 public:
     OrthographicProjection() = default;
-    std::vector<double> projectPoint(const std::vector<double>& point) const override;
+    void projectPoints(const double* in, std::size_t count, std::size_t dim,
+                       double* out) const override;
+    ProjectionParams kernelParams() const override {
+        return OrthographicParams{};
+    }
 
     std::shared_ptr<Projection> clone() const override;
 };
@@ -93,10 +134,24 @@ public:
 class StereographicProjection : public Projection {
 public:
     StereographicProjection() = default;
-    std::vector<double> projectPoint(const std::vector<double>& point) const override;
+    void projectPoints(const double* in, std::size_t count, std::size_t dim,
+                       double* out) const override;
+    ProjectionParams kernelParams() const override {
+        return StereographicParams{};
+    }
 
     std::shared_ptr<Projection> clone() const override;
 
 };
 
+/// Class name of a built-in projection, used in error messages.
+const char* projectionName(const ProjectionParams& params);
+
+/**
+ * @brief Creates the built-in projection described by @p params.
+ *
+ * @return nullptr for std::monostate.
+ */
+std::shared_ptr<Projection> makeProjection(const ProjectionParams& params);
+
 #endif // PROJECTION_H
@@ -2,15 +2,14 @@
 #include <cmath>
 #include <QString>
 #include <QDebug>
+#include "geometryKernels.h"
 
 Rotator::Rotator(std::size_t axis1, std::size_t axis2, double angle)
     : axis1_(axis1), axis2_(axis2), angle_(angle)
 {
 }
 
-NDShape Rotator::applyRotation(const NDShape& shape) const {
-    std::size_t dim = shape.getDimension();
-
+void Rotator::checkAxes(std::size_t dim) const {
     // Validate that the provided axes are within the dimension range and distinct.
     if (axis1_ >= dim || axis2_ >= dim) {
         QString msg = QString("Axis index out of range: axis1=%1, axis2=%2, dimension=%3")
@@ -24,23 +23,52 @@ NDShape Rotator::applyRotation(const NDShape& shape) const {
         qWarning() << msg;
         throw std::invalid_argument(msg.toStdString());
     }
+}
+
+NDShape Rotator::applyRotation(const NDShape& shape) const {
+    std::size_t dim = shape.getDimension();
+    checkAxes(dim);
 
     NDShape rotatedShape = shape;
     double cosA = std::cos(angle_);
     double sinA = std::sin(angle_);
 
-    // Retrieve all vertices from the shape and apply the rotation.
-    auto allVertices = shape.getAllVertices();
-    for (const auto& [vertexId, coords] : allVertices) {
-        double x = coords[axis1_];
-        double y = coords[axis2_];
+    // Rotate every vertex in place in the copied coordinate buffer.
+    kernelsFor(dim).rotatePlane(rotatedShape.coordinateData(), rotatedShape.vertexIds().size(),
+                                dim, axis1_, axis2_, cosA, sinA);
+
+    return rotatedShape;
+}
 
-        std::vector<double> newCoords = coords;
-        newCoords[axis1_] = x * cosA - y * sinA;
-        newCoords[axis2_] = x * sinA + y * cosA;
+void Rotator::composeInto(double* matrix, std::size_t dim) const {
+    checkAxes(dim);
+    double cosA = std::cos(angle_);
+    double sinA = std::sin(angle_);
 
-        rotatedShape.setVertexCoords(vertexId, newCoords);
+    // only rows axis1_ and axis2_ of the product change
+    double* rowA = matrix + axis1_ * dim;
+    double* rowB = matrix + axis2_ * dim;
+    for (std::size_t j = 0; j < dim; ++j) {
+        double a = rowA[j];
+        double b = rowB[j];
+        rowA[j] = a * cosA - b * sinA;
+        rowB[j] = a * sinA + b * cosA;
     }
+}
 
-    return rotatedShape;
+bool Rotator::commutesWith(const Rotator& other) const {
+    const bool samePlane = (axis1_ == other.axis1_ && axis2_ == other.axis2_)
+                        || (axis1_ == other.axis2_ && axis2_ == other.axis1_);
+    const bool disjoint  = axis1_ != other.axis1_ && axis1_ != other.axis2_
+                        && axis2_ != other.axis1_ && axis2_ != other.axis2_;
+    return samePlane || disjoint;
+}
+
+std::vector<double> Rotator::composeChain(const std::vector<Rotator>& chain, std::size_t dim) {
+    std::vector<double> matrix(dim * dim, 0.0);
+    for (std::size_t i = 0; i < dim; ++i)
+        matrix[i * dim + i] = 1.0;
+    for (const Rotator& r : chain)
+        r.composeInto(matrix.data(), dim);
+    return matrix;
 }
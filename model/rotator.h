@@ -2,6 +2,7 @@
 #define ROTATOR_H
 
 #include <cstddef>
+#include <vector>
 #include "NDShape.h"
 
 /**
@@ -36,6 +37,34 @@ public:
      */
     NDShape applyRotation(const NDShape& shape) const;
 
+    /**
+     * @brief Left-multiplies a row-major dim×dim matrix by this rotation's
+     *        Givens matrix, i.e. appends the rotation to a composed chain.
+     *
+     * @throws std::invalid_argument If either axis index is out of range or if both axes are identical.
+     */
+    void composeInto(double* matrix, std::size_t dim) const;
+
+    /**
+     * @brief Composes a chain of rotators, applied first to last, into one
+     *        orthonormal row-major dim×dim matrix.
+     *
+     * @return The identity for an empty chain.
+     * @throws std::invalid_argument If any rotator does not fit @p dim.
+     */
+    static std::vector<double> composeChain(const std::vector<Rotator>& chain, std::size_t dim);
+
+    /**
+     * @brief Whether the two rotations can be applied in either order:
+     *        their planes share no axis, or they are the same plane.
+     */
+    bool commutesWith(const Rotator& other) const;
+
+    bool operator==(const Rotator& other) const {
+        return axis1_ == other.axis1_ && axis2_ == other.axis2_ && angle_ == other.angle_;
+    }
+    bool operator!=(const Rotator& other) const { return !(*this == other); }
+
     /* ---------- read‑only getters ---------- */
     std::size_t axis1() const { return axis1_; }
     std::size_t axis2() const { return axis2_; }
@@ -47,6 +76,9 @@ public:
     void setAngle(double angle)      { angle_ = angle; }
 
 private:
+    /// Throws std::invalid_argument unless both axes are distinct and below @p dim.
+    void checkAxes(std::size_t dim) const;
+
     std::size_t axis1_;
     std::size_t axis2_;
     double angle_;
@@ -1,11 +1,63 @@
 #include "scene.h"
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include <set>
+#include <variant>
 #include <stdexcept>
 #include <QString>
 #include <QDebug>
 #include "projection.h"
+#include "geometryKernels.h"
+#include "isoclinicRotation.h"
+#include "parallelFor.h"
+
+namespace {
+/// Scale and offset are given in scene dimension and apply to the first @p dim axes.
+void scaleOffsetPointers(const SceneObject& obj, std::size_t dim,
+                         const double*& scale, const double*& offset)
+{
+    scale  = (!obj.scale.empty()  && obj.scale.size()  >= dim) ? obj.scale.data()  : nullptr;
+    offset = (!obj.offset.empty() && obj.offset.size() >= dim) ? obj.offset.data() : nullptr;
+}
+
+/// Same shape pointer, or an untouched copy of it (SceneObject::clone() copies the shape).
+bool sameShape(const std::shared_ptr<NDShape>& a, const std::shared_ptr<NDShape>& b)
+{
+    return a == b || (a && b && a->sharesDataWith(*b));
+}
+
+/// Same projection pointer, or built-in projections with equal parameters.
+bool sameProjection(const std::shared_ptr<Projection>& a, const std::shared_ptr<Projection>& b)
+{
+    if (a == b) return true;
+    if (!a || !b) return false;
+    const ProjectionParams pa = a->kernelParams();
+    return !std::holds_alternative<std::monostate>(pa) && pa == b->kernelParams();
+}
+
+/// Index of the one rotator whose angle differs between the chains, if it
+/// commutes with every later one (then now = Givens(Δθ)·before); now.size() otherwise.
+std::size_t angleOnlyChange(const std::vector<Rotator>& before, const std::vector<Rotator>& now)
+{
+    if (before.size() != now.size())
+        return now.size();
+
+    std::size_t changed = now.size();
+    for (std::size_t i = 0; i < now.size(); ++i) {
+        if (now[i] == before[i])
+            continue;
+        if (changed != now.size()
+            || now[i].axis1() != before[i].axis1() || now[i].axis2() != before[i].axis2())
+            return now.size();
+        changed = i;
+    }
+    for (std::size_t j = changed + 1; j < now.size(); ++j)
+        if (!now[changed].commutesWith(now[j]))
+            return now.size();
+    return changed;
+}
+} // namespace
 
 SceneObject SceneObject::clone()
 {
@@ -15,6 +67,116 @@ SceneObject SceneObject::clone()
     return copy;
 }
 
+std::shared_ptr<const RotationCache> SceneObject::rotationMatrix(std::size_t dim) const
+{
+    auto cached = std::atomic_load(&rotationCache_);
+    if (cached && cached->dimension == dim && cached->rotators == rotators)
+        return cached;
+
+    auto fresh = std::make_shared<RotationCache>();
+    fresh->rotators  = rotators;
+    fresh->dimension = dim;
+    // a 4-D chain folds into a quaternion pair, which stays orthonormal however long it gets
+    fresh->matrix    = dim == 4 ? IsoclinicPair::fromChain(rotators).toMatrix()
+                                : Rotator::composeChain(rotators, dim);
+
+    std::shared_ptr<const RotationCache> result = std::move(fresh);
+    std::atomic_store(&rotationCache_, result);
+    return result;
+}
+
+std::shared_ptr<const TransformCache> SceneObject::transformMatrix(std::size_t dim,
+                                                                   std::size_t targetDim) const
+{
+    const ProjectionParams proj = projection ? projection->kernelParams() : ProjectionParams{};
+
+    auto cached = std::atomic_load(&transformCache_);
+    if (cached && cached->transform.dimension == dim
+        && cached->transform.targetDimension == targetDim
+        && cached->projection == proj && cached->rotators == rotators
+        && cached->scale == scale && cached->offset == offset)
+        return cached;
+
+    const double* scalePtr;
+    const double* offsetPtr;
+    scaleOffsetPointers(*this, targetDim, scalePtr, offsetPtr);
+
+    std::shared_ptr<const RotationCache> rotation;
+    if (!rotators.empty())
+        rotation = rotationMatrix(dim);
+
+    auto fresh = std::make_shared<TransformCache>();
+    fresh->rotators   = rotators;
+    fresh->projection = proj;
+    fresh->scale      = scale;
+    fresh->offset     = offset;
+    fresh->transform  = composeHomogeneous(dim, targetDim,
+                                           rotation ? rotation->matrix.data() : nullptr,
+                                           proj, scalePtr, offsetPtr);
+    fresh->singleMatrix.assign(fresh->transform.matrix.begin(), fresh->transform.matrix.end());
+
+    std::shared_ptr<const TransformCache> result = std::move(fresh);
+    std::atomic_store(&transformCache_, result);
+    return result;
+}
+
+std::shared_ptr<const RotatedCoordsCache> SceneObject::rotatedCoords(std::size_t dim) const
+{
+    auto cached = std::atomic_load(&rotatedCoordsCache_);
+    const bool kept = cached && cached->columns.size() == dim && sameShape(cached->shape, shape);
+    if (kept && cached->rotators == rotators)
+        return cached;
+
+    // compare with the kept coordinates, or else with the last composed transform
+    std::shared_ptr<const TransformCache> composed;
+    const std::vector<Rotator>* before = nullptr;
+    if (kept)
+        before = &cached->rotators;
+    else if ((composed = std::atomic_load(&transformCache_)))
+        before = &composed->rotators;
+
+    const std::size_t k = before ? angleOnlyChange(*before, rotators) : rotators.size();
+    if (k == rotators.size()) {
+        std::atomic_store(&rotatedCoordsCache_, std::shared_ptr<const RotatedCoordsCache>());
+        return nullptr;
+    }
+
+    auto fresh = std::make_shared<RotatedCoordsCache>();
+    fresh->shape    = shape;
+    fresh->rotators = rotators;
+
+    const std::size_t count = shape->vertexIds().size();
+    if (kept && cached->deltaSteps + 1 < kRotationReanchorInterval) {
+        // only the two columns of the rotation plane change
+        const Rotator& r     = rotators[k];
+        const double   delta = r.angle() - cached->rotators[k].angle();
+        std::vector<double> x(count), y(count);
+        kernelsFor(dim).rotateColumns(cached->columns[r.axis1()]->data(),
+                                      cached->columns[r.axis2()]->data(), x.data(), y.data(),
+                                      count, std::cos(delta), std::sin(delta));
+        fresh->columns    = cached->columns;
+        fresh->deltaSteps = cached->deltaSteps + 1;
+        fresh->columns[r.axis1()] = std::make_shared<const std::vector<double>>(std::move(x));
+        fresh->columns[r.axis2()] = std::make_shared<const std::vector<double>>(std::move(y));
+    } else {
+        // a drag starts, or the coordinates are due to be re-anchored on the shape
+        const double* source = shape->coordinateData();
+        std::vector<double> rows(source, source + count * dim);
+        kernelsFor(dim).transformRows(rotationMatrix(dim)->matrix.data(), rows.data(), count, dim);
+        fresh->columns.reserve(dim);
+        for (std::size_t i = 0; i < dim; ++i) {
+            std::vector<double> column(count);
+            for (std::size_t v = 0; v < count; ++v)
+                column[v] = rows[v * dim + i];
+            fresh->columns.push_back(std::make_shared<const std::vector<double>>(std::move(column)));
+        }
+    }
+
+    std::shared_ptr<const RotatedCoordsCache> result = std::move(fresh);
+    std::atomic_store(&rotatedCoordsCache_, result);
+    return result;
+}
+
 Scene::~Scene() { qDebug() << "Scene cleared"; }
 
 QUuid Scene::addObject(QUuid uid, int id, QString name,
@@ -56,6 +218,7 @@ void Scene::removeObject(const QUuid& uid)
     if (it == objects_.end())
         throw std::out_of_range("No object with given uid");
     objects_.erase(it, objects_.end());
+    conversionCache_.erase(uid);
 }
 
 std::weak_ptr<SceneObject> Scene::getObject(const QUuid& uid) const
@@ -83,6 +246,13 @@ void Scene::setObject(const QUuid& uid,
     if (!offset.empty() && offset.size() != sceneDimension_)
         throw std::invalid_argument("Offset dimension mismatch");
 
+    SceneObjectVersions& v = sp->versions;
+    if (!sameShape(sp->shape, shape))                ++v.shape;
+    if (!sameProjection(sp->projection, projection)) ++v.projection;
+    if (sp->rotators   != rotators)   ++v.rotators;
+    if (sp->scale      != scale)      ++v.scale;
+    if (sp->offset     != offset)     ++v.offset;
+
     sp->name       = std::move(name);
     sp->shape      = std::move(shape);
     sp->projection = std::move(projection);
@@ -102,47 +272,202 @@ std::size_t Scene::objectCount() const {
     return objects_.size();
 }
 
-inline std::vector<Rotator>
-collapseAdjacentRotators(const std::vector<Rotator>& src)
+std::size_t ConvertedData::rowOf(std::size_t vertexId) const
 {
-    std::vector<Rotator> collapsed;
-    if (src.empty()) return collapsed;
+    auto it = std::lower_bound(vertexIds.begin(), vertexIds.end(), vertexId);
+    return (it != vertexIds.end() && *it == vertexId)
+               ? static_cast<std::size_t>(it - vertexIds.begin())
+               : vertexIds.size();
+}
 
-    std::size_t  curA1   = src.front().axis1();
-    std::size_t  curA2   = src.front().axis2();
-    double       curAng  = src.front().angle();
+std::vector<double> ConvertedData::rowVector(std::size_t k) const
+{
+    if (precision == ConversionPrecision::Single)
+        return { coordsSingle.begin() + k * dimension, coordsSingle.begin() + (k + 1) * dimension };
+    return row(k).toVector();
+}
 
-    const auto flush = [&]() {
-        constexpr double Tau = 2.0 * 3.14159265358979323846;
-        curAng = std::fmod(curAng, Tau);
-        collapsed.emplace_back(curA1, curA2, curAng);
-    };
+namespace {
+template<class T>
+void writeRowsAsFloat3(const T* in, std::size_t count, std::size_t n, float* out, std::size_t stride)
+{
+    const std::size_t copied = n < 3 ? n : 3;
+    for (std::size_t k = 0; k < count; ++k, in += n, out += stride) {
+        std::size_t i = 0;
+        for (; i < copied; ++i)
+            out[i] = static_cast<float>(in[i]);
+        for (; i < 3; ++i)
+            out[i] = 0.0f;
+    }
+}
+} // namespace
+
+void ConvertedData::writeFloat3(float* out, std::size_t stride) const
+{
+    if (precision == ConversionPrecision::Single)
+        writeRowsAsFloat3(coordsSingle.data(), vertexCount(), dimension, out, stride);
+    else
+        writeRowsAsFloat3(coords.data(), vertexCount(), dimension, out, stride);
+}
+
+ConvertedData Scene::convertObject(const SceneObject& obj, int sceneDimension,
+                                   const ConversionOptions& options)
+{
+    return convertObjectTo(obj, sceneDimension, options, nullptr, 0);
+}
 
-    for (std::size_t i = 1; i < src.size(); ++i) {
-        const Rotator& r = src[i];
-        if (r.axis1() == curA1 && r.axis2() == curA2) {
-            curAng += r.angle();
+ConvertedData Scene::convertObject(const SceneObject& obj, int sceneDimension,
+                                   const ConversionOptions& options,
+                                   float* positions, std::size_t stride)
+{
+    if (!positions || stride < 3) {
+        QString msg = "Positions need a buffer and a stride of at least 3 floats.";
+        qWarning() << msg;
+        throw std::invalid_argument(msg.toStdString());
+    }
+    return convertObjectTo(obj, sceneDimension, options, positions, stride);
+}
+
+ConvertedData Scene::convertObjectTo(const SceneObject& obj, int sceneDimension,
+                                     const ConversionOptions& options,
+                                     float* positions, std::size_t stride)
+{
+    const NDShape&    shape     = *obj.shape;
+    const std::size_t dim       = shape.getDimension();
+    const std::size_t targetDim = std::min<std::size_t>(dim, sceneDimension);
+
+    if (!obj.projection && dim > targetDim)
+        throw std::invalid_argument("Projection \"None\" is not allowed for this object.");
+
+    const ProjectionParams proj = obj.projection ? obj.projection->kernelParams()
+                                                 : ProjectionParams{};
+    const bool custom = dim > targetDim && std::holds_alternative<std::monostate>(proj);
+    if (custom || (positions && targetDim > 3)) {
+        // no kernel writes these directly; narrow a regular conversion instead
+        ConvertedData res = custom ? convertObjectStaged(obj, sceneDimension)
+                                   : convertObjectTo(obj, sceneDimension, options, nullptr, 0);
+        if (positions) {
+            res.writeFloat3(positions, stride);
+            res.coords.clear();
+            res.coordsSingle.clear();
+        }
+        return res;
+    }
+
+    // After an angle-only edit the kept rotated coordinates only need the
+    // projection, scale and offset, whose matrix is diagonal; otherwise one full
+    // matrix. The shared_ptrs keep either alive if another thread replaces it.
+    std::shared_ptr<const RotatedCoordsCache> rotated;
+    if (options.incrementalRotation && !obj.rotators.empty())
+        rotated = obj.rotatedCoords(dim);
+
+    std::shared_ptr<const TransformCache> transform;
+    HomogeneousTransform unrotated;
+    std::vector<float>   unrotatedSingle, offsetSingle;
+    const double*        offset = nullptr;
+    if (rotated) {
+        const double* scale;
+        scaleOffsetPointers(obj, targetDim, scale, offset);
+        unrotated = composeHomogeneous(dim, targetDim, nullptr, proj, scale, offset);
+        unrotatedSingle.assign(unrotated.matrix.begin(), unrotated.matrix.end());
+        if (offset)
+            offsetSingle.assign(offset, offset + targetDim);
+    } else {
+        transform = obj.transformMatrix(dim, targetDim);
+    }
+
+    ConvertedData res;
+    res.objectUid = obj.uid;
+    res.dimension = targetDim;
+    res.vertexIds = shape.vertexIds();
+    res.edges     = shape.getEdges();
+    res.precision = positions ? ConversionPrecision::Single : options.precision;
+    const bool single = res.precision == ConversionPrecision::Single;
+    const std::size_t count = res.vertexIds.size();
+    if (!positions) {
+        if (single)
+            res.coordsSingle.resize(count * targetDim);
+        else
+            res.coords.resize(count * targetDim);
+    }
+    res.valid.resize(count);
+
+    // single precision rows go to the caller's buffer at its stride, or to coordsSingle
+    float* outF = positions ? positions : res.coordsSingle.data();
+    const std::size_t strideF = positions ? stride : targetDim;
+
+    const KernelTable& kernels = kernelsFor(dim);
+    const double* in     = shape.coordinateData();
+    unsigned char* valid = res.valid.data();
+    const bool    divide = rotated ? unrotated.divide : transform->transform.divide;
+    const float*  offsetF = offset ? offsetSingle.data() : nullptr;
+
+    // rows are independent, so any split gives the serial result
+    std::atomic<std::size_t> invalid{0};
+    auto convertRange = [&](std::size_t b, std::size_t e) {
+        if (rotated) {
+            std::vector<const double*> columns(dim);
+            for (std::size_t i = 0; i < dim; ++i)
+                columns[i] = rotated->columns[i]->data() + b;
+            if (single)
+                invalid += kernels.convertDiagonalSingle(columns.data(), outF + b * strideF,
+                                                         e - b, dim, targetDim,
+                                                         unrotatedSingle.data(), offsetF,
+                                                         divide, valid + b, strideF);
+            else
+                invalid += kernels.convertDiagonal(columns.data(),
+                                                   res.coords.data() + b * targetDim, e - b, dim,
+                                                   targetDim, unrotated.matrix.data(), offset,
+                                                   divide, valid + b);
+        } else if (single) {
+            invalid += kernels.convertHomogeneousSingle(in + b * dim, outF + b * strideF,
+                                                        e - b, dim, targetDim,
+                                                        transform->singleMatrix.data(), divide,
+                                                        valid + b, strideF);
         } else {
-            flush();
-            curA1  = r.axis1();
-            curA2  = r.axis2();
-            curAng = r.angle();
+            invalid += kernels.convertHomogeneous(in + b * dim, res.coords.data() + b * targetDim,
+                                                  e - b, dim, targetDim,
+                                                  transform->transform.matrix.data(), divide,
+                                                  valid + b);
         }
+        // positions below three axes are padded with zeros
+        if (positions)
+            for (std::size_t v = b; v < e; ++v)
+                for (std::size_t i = targetDim; i < 3; ++i)
+                    positions[v * stride + i] = 0.0f;
+    };
+    if (options.parallel && count >= options.minParallelVertices)
+        parallelForRange(0, count, options.grainSize, convertRange);
+    else
+        convertRange(0, count);
+
+    res.invalidCount = invalid;
+    if (res.invalidCount != 0) {
+        // drop the edges that lost an endpoint, then report once
+        auto lost = [&res](const std::pair<std::size_t, std::size_t>& e) {
+            return !res.isValid(res.rowOf(e.first)) || !res.isValid(res.rowOf(e.second));
+        };
+        res.edges.erase(std::remove_if(res.edges.begin(), res.edges.end(), lost), res.edges.end());
+
+        qWarning() << QString("%1: %2 of %3 vertices could not be projected (division by zero in %4).")
+                          .arg(obj.name).arg(res.invalidCount).arg(count).arg(projectionName(proj));
     }
-    flush();
-    return collapsed;
+    return res;
 }
 
-ConvertedData Scene::convertObject(const SceneObject& obj, int sceneDimension)
+ConvertedData Scene::convertObjectStaged(const SceneObject& obj, int sceneDimension)
 {
     ConvertedData res;
     res.objectUid = obj.uid;
 
-    auto optimisedRotators = collapseAdjacentRotators(obj.rotators);
-
+    // the whole rotator chain is one cached matrix applied in a single pass
     NDShape transformed = *obj.shape;
-    for (const Rotator& r : optimisedRotators)
-        transformed = r.applyRotation(transformed);
+    if (!obj.rotators.empty()) {
+        const std::size_t dim = transformed.getDimension();
+        auto rotation = obj.rotationMatrix(dim);
+        kernelsFor(dim).transformRows(rotation->matrix.data(), transformed.coordinateData(),
+                                      transformed.vertexIds().size(), dim);
+    }
 
     if(!obj.projection && transformed.getDimension() > sceneDimension)
         throw std::invalid_argument("Projection \"None\" is not allowed for this object.");
@@ -151,33 +476,88 @@ ConvertedData Scene::convertObject(const SceneObject& obj, int sceneDimension)
                             ? obj.projection->projectShapeToDimension(transformed, sceneDimension)
                             : transformed;
 
-    res.vertices = projected.getAllVertices();
-    res.edges    = projected.getEdges();
+    const std::size_t dim = projected.getDimension();
+    const double* scale;
+    const double* offset;
+    scaleOffsetPointers(obj, dim, scale, offset);
+    if (scale || offset)
+        kernelsFor(dim).scaleOffset(projected.coordinateData(), projected.vertexIds().size(),
+                                    dim, scale, offset);
 
-    if (!obj.scale.empty()) {
-        for (auto& v : res.vertices)
-            for (std::size_t i = 0; i < v.second.size(); ++i)
-                v.second[i] *= obj.scale[i];
-    }
-    if (!obj.offset.empty()) {
-        for (auto& v : res.vertices)
-            for (std::size_t i = 0; i < v.second.size(); ++i)
-                v.second[i] += obj.offset[i];
-    }
+    res.dimension = dim;
+    res.vertexIds = projected.vertexIds();
+    res.coords.assign(projected.coordinateData(),
+                      projected.coordinateData() + res.vertexIds.size() * dim);
+    res.edges     = projected.getEdges();
     return res;
 }
 
-ConvertedData Scene::convertObject(const QUuid& uid) const
+std::shared_ptr<const ConvertedData> Scene::convertObject(const QUuid& uid) const
 {
     auto sp = getObject(uid).lock();
     if (!sp) throw std::out_of_range("Stale pointer for uid");
-    return convertObject(*sp, sceneDimension_);
+
+    CachedConversion& entry = conversionCache_[uid];
+    if (entry.data && entry.versions == sp->versions && entry.sceneDimension == sceneDimension_) {
+        ++cacheStats_.hits;
+        return entry.data;
+    }
+
+    ++cacheStats_.misses;
+    entry.data           = std::make_shared<const ConvertedData>(
+        convertObject(*sp, static_cast<int>(sceneDimension_), conversionOptions_));
+    entry.versions       = sp->versions;
+    entry.sceneDimension = sceneDimension_;
+    return entry.data;
 }
 
-std::vector<ConvertedData> Scene::convertAllObjects() const
+std::vector<std::shared_ptr<const ConvertedData>> Scene::convertAllObjects() const
 {
-    std::vector<ConvertedData> v;
-    for (auto& o : objects_) v.push_back(convertObject(o->uid));
+    std::vector<std::shared_ptr<const ConvertedData>> v(objects_.size());
+
+    // serve what the cache can, collect the rest
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < objects_.size(); ++i) {
+        const SceneObject& obj = *objects_[i];
+        auto it = conversionCache_.find(obj.uid);
+        if (it != conversionCache_.end() && it->second.data
+            && it->second.versions == obj.versions
+            && it->second.sceneDimension == sceneDimension_) {
+            ++cacheStats_.hits;
+            v[i] = it->second.data;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    // largest objects first, so a big one never starts last
+    auto cost = [this](std::size_t i) -> std::size_t {
+        const NDShape* shape = objects_[i]->shape.get();
+        if (!shape) return 0;
+        const std::size_t dim = shape->getDimension();
+        return shape->vertexIds().size() * dim * dim + shape->getEdges().size();
+    };
+    std::vector<std::size_t> costs(objects_.size());
+    for (std::size_t i : pending) costs[i] = cost(i);
+    std::stable_sort(pending.begin(), pending.end(),
+                     [&costs](std::size_t a, std::size_t b) { return costs[a] > costs[b]; });
+
+    // workers only read the objects; the cache is updated on this thread
+    const int sceneDimension = static_cast<int>(sceneDimension_);
+    parallelFor(pending.size(), [&](std::size_t k) {
+        const std::size_t i = pending[k];
+        v[i] = std::make_shared<const ConvertedData>(
+            convertObject(*objects_[i], sceneDimension, conversionOptions_));
+    });
+
+    for (std::size_t i : pending) {
+        const SceneObject& obj = *objects_[i];
+        CachedConversion& entry = conversionCache_[obj.uid];
+        entry.versions       = obj.versions;
+        entry.sceneDimension = sceneDimension_;
+        entry.data           = v[i];
+        ++cacheStats_.misses;
+    }
     return v;
 }
 
@@ -187,3 +567,63 @@ void Scene::setSceneDimension(std::size_t d)
     sceneDimension_ = d;
 }
 std::size_t Scene::getSceneDimension() const { return sceneDimension_; }
+
+ConversionCacheStats Scene::conversionCacheStats() const { return cacheStats_; }
+void Scene::resetConversionCacheStats() { cacheStats_ = {}; }
+
+void Scene::setConversionOptions(const ConversionOptions& options)
+{
+    // cached results are only reusable in the precision they were made in
+    if (options.precision != conversionOptions_.precision)
+        conversionCache_.clear();
+    conversionOptions_ = options;
+}
+
+PrecisionReport Scene::checkSinglePrecision() const
+{
+    ConversionOptions doubleOptions = conversionOptions_;
+    ConversionOptions singleOptions = conversionOptions_;
+    doubleOptions.precision = ConversionPrecision::Double;
+    singleOptions.precision = ConversionPrecision::Single;
+
+    const int sceneDimension = static_cast<int>(sceneDimension_);
+    std::vector<ConvertedData> reference(objects_.size()), single(objects_.size());
+    parallelFor(objects_.size(), [&](std::size_t i) {
+        reference[i] = convertObject(*objects_[i], sceneDimension, doubleOptions);
+        single[i]    = convertObject(*objects_[i], sceneDimension, singleOptions);
+    });
+
+    PrecisionReport report;
+    report.objects = objects_.size();
+    for (std::size_t i = 0; i < objects_.size(); ++i) {
+        const ConvertedData& d = reference[i];
+        const ConvertedData& s = single[i];
+        for (std::size_t k = 0; k < d.vertexCount(); ++k) {
+            if (d.isValid(k) != s.isValid(k)) {
+                ++report.validityMismatches;
+                continue;
+            }
+            if (!d.isValid(k))
+                continue;
+            ++report.vertices;
+            const std::vector<double> exact = d.rowVector(k);
+            const std::vector<double> approx = s.rowVector(k);
+            for (std::size_t c = 0; c < exact.size(); ++c) {
+                const double abs = std::fabs(approx[c] - exact[c]);
+                const double rel = abs / std::max(1.0, std::fabs(exact[c]));
+                report.maxAbsError = std::max(report.maxAbsError, abs);
+                if (rel > report.maxRelError) {
+                    report.maxRelError = rel;
+                    report.worstObject = d.objectUid;
+                }
+            }
+        }
+    }
+
+    qDebug() << QString("Single precision over %1 vertices: max abs error %2, max rel error %3, "
+                        "%4 validity mismatches.")
+                    .arg(report.vertices).arg(report.maxAbsError).arg(report.maxRelError)
+                    .arg(report.validityMismatches);
+    return report;
+}
+const ConversionOptions& Scene::conversionOptions() const { return conversionOptions_; }
@@ -3,12 +3,78 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <unordered_map>
 #include <QString>
 #include <QUuid>
 #include "NDShape.h"
 #include "projection.h"
 #include "rotator.h"
 
+/// Hash functor so QUuid can key standard unordered containers.
+struct UidHash {
+    std::size_t operator()(const QUuid& uid) const noexcept { return qHash(uid); }
+};
+
+/**
+ * @brief Per-field change counters of a SceneObject.
+ *
+ * Scene bumps a counter whenever it replaces the corresponding field, so
+ * equal versions mean equal conversion input.
+ */
+struct SceneObjectVersions {
+    std::uint64_t shape      = 0;
+    std::uint64_t rotators   = 0;
+    std::uint64_t projection = 0;
+    std::uint64_t scale      = 0;
+    std::uint64_t offset     = 0;
+
+    bool operator==(const SceneObjectVersions& o) const {
+        return shape == o.shape && rotators == o.rotators && projection == o.projection
+               && scale == o.scale && offset == o.offset;
+    }
+    bool operator!=(const SceneObjectVersions& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief An object's rotator chain compiled into one rotation matrix.
+ */
+struct RotationCache {
+    std::vector<Rotator> rotators;    ///< chain the matrix was built from
+    std::size_t          dimension = 0;
+    std::vector<double>  matrix;      ///< row-major dimension×dimension, orthonormal
+};
+
+/**
+ * @brief An object's shape rotated by its rotator chain, kept to follow angle edits.
+ *
+ * Stored dimension-major, so a plane rotation replaces two columns and
+ * shares the others with the cache it was derived from.
+ */
+struct RotatedCoordsCache {
+    using Column = std::shared_ptr<const std::vector<double>>;
+
+    std::shared_ptr<NDShape> shape;          ///< shape the coordinates were rotated from
+    std::vector<Rotator>     rotators;       ///< chain they are rotated by
+    std::vector<Column>      columns;        ///< one per axis, in the shape's slot order
+    std::size_t              deltaSteps = 0; ///< Givens updates since they were rotated from the shape
+};
+
+/// Givens updates of a RotatedCoordsCache before it is rotated afresh from the shape.
+constexpr std::size_t kRotationReanchorInterval = 64;
+
+/**
+ * @brief An object's complete conversion transform and the inputs it was composed from.
+ */
+struct TransformCache {
+    std::vector<Rotator> rotators;
+    ProjectionParams     projection;
+    std::vector<double>  scale;
+    std::vector<double>  offset;
+    HomogeneousTransform transform;
+    std::vector<float>   singleMatrix;   ///< transform.matrix rounded once, for single precision
+};
+
 /**
  * @brief Structure representing a scene object.
  *
@@ -21,6 +87,10 @@
  *  - A list of Rotator objects applied sequentially.
  *  - A scale vector (in scene dimension) applied after projection.
  *  - An offset vector (in scene dimension) applied after scaling.
+ *  - Version counters of the fields above, maintained by Scene.
+ *
+ * The shape is treated as immutable once it belongs to a scene: edits
+ * replace the pointer through Scene::setObject().
  */
 struct SceneObject {
     QUuid                     uid;
@@ -31,22 +101,154 @@ struct SceneObject {
     std::vector<Rotator>      rotators;
     std::vector<double>       scale;
     std::vector<double>       offset;
+    SceneObjectVersions       versions;
 
     /// Deep copy (keeps the same uid and id).
     SceneObject clone();
+
+    /**
+     * @brief Returns the rotators composed into a single dim×dim matrix.
+     *
+     * The result is cached and rebuilt only when `rotators` or @p dim no
+     * longer match the cached chain. Safe to call from several threads.
+     * In 4-D the chain is folded as an IsoclinicPair rather than as Givens
+     * matrices. That keeps long chains orthonormal; it does not make the
+     * per-vertex conversion any faster.
+     *
+     * @throws std::invalid_argument If a rotator does not fit @p dim.
+     */
+    std::shared_ptr<const RotationCache> rotationMatrix(std::size_t dim) const;
+
+    /**
+     * @brief Returns rotation, projection, scale and offset composed into one
+     *        homogeneous matrix mapping dim to targetDim.
+     *
+     * Cached like rotationMatrix(); rebuilt when any input or dimension
+     * changes. The projection must be a built-in one when targetDim < dim.
+     */
+    std::shared_ptr<const TransformCache> transformMatrix(std::size_t dim,
+                                                          std::size_t targetDim) const;
+
+    /**
+     * @brief Returns the shape's vertices rotated by the current chain, if
+     *        they follow from the previous chain by one plane rotation.
+     *
+     * That is the case when the only change is one rotator's angle and
+     * that rotator commutes with every rotator after it: the new chain is
+     * then Givens(Δθ) times the old one. The coordinates are rotated from
+     * the shape when such an edit follows a transformMatrix() call (a
+     * rotator drag starts), then updated with a single Givens pass per
+     * edit and rotated afresh every kRotationReanchorInterval edits to
+     * bound the drift. Safe to call from several threads.
+     *
+     * @return null, dropping the kept coordinates, when the chain changed in any other way.
+     */
+    std::shared_ptr<const RotatedCoordsCache> rotatedCoords(std::size_t dim) const;
+
+private:
+    mutable std::shared_ptr<const RotationCache>      rotationCache_;
+    mutable std::shared_ptr<const TransformCache>     transformCache_;
+    mutable std::shared_ptr<const RotatedCoordsCache> rotatedCoordsCache_;
 };
 
+/// Floating-point type of the per-vertex conversion.
+enum class ConversionPrecision { Double, Single };
+
 /**
  * @brief Structure representing converted data.
  *
  * Conversion extracts:
- *  - vertices: a list of pairs where the first element is the vertex ID and the second is the vector of coordinates.
- *  - edges: a list of pairs of vertex IDs representing the shape's edges.
+ *  - vertexIds: the vertex IDs in ascending order;
+ *  - coords: one row of `dimension` coordinates per vertex, in the order of vertexIds
+ *    (coordsSingle instead for a single-precision conversion);
+ *  - valid: one flag per vertex, 0 where the projection was undefined
+ *    (empty means every vertex is valid);
+ *  - edges: a list of pairs of vertex IDs representing the shape's edges,
+ *    without the edges that touch an invalid vertex.
  */
 struct ConvertedData {
     QUuid objectUid;
-    std::vector<std::pair<std::size_t, std::vector<double>>> vertices;
+    std::size_t dimension = 0;
+    std::vector<std::size_t> vertexIds;
+    std::vector<double> coords;
+    std::vector<float> coordsSingle;
+    ConversionPrecision precision = ConversionPrecision::Double;
+    std::vector<unsigned char> valid;
+    std::size_t invalidCount = 0;
     std::vector<std::pair<std::size_t, std::size_t>> edges;
+
+    std::size_t vertexCount() const { return vertexIds.size(); }
+
+    /// Whether row k holds a projected vertex; its coordinates are meaningless otherwise.
+    bool isValid(std::size_t k) const { return valid.empty() || valid[k] != 0; }
+
+    /// Coordinates of the k-th vertex (row k); double precision only.
+    CoordSpan row(std::size_t k) const {
+        return CoordSpan(coords.data() + k * dimension, dimension);
+    }
+
+    /// Coordinates of the k-th vertex, in either precision.
+    std::vector<double> rowVector(std::size_t k) const;
+
+    /// Row of the vertex with the given ID, or vertexCount() if there is none.
+    std::size_t rowOf(std::size_t vertexId) const;
+
+    /**
+     * @brief Writes every row as a float x, y, z position, ready for upload.
+     *
+     * Row k lands at @p out + k·@p stride; axes beyond the third are
+     * dropped and missing ones written as 0. Invalid rows are written too.
+     *
+     * @param stride Distance between positions in floats, at least 3.
+     */
+    void writeFloat3(float* out, std::size_t stride = 3) const;
+};
+
+/**
+ * @brief Controls how a single object's vertices are split across threads.
+ *
+ * Objects with at least minParallelVertices vertices are converted in
+ * chunks of grainSize vertices on the global QThreadPool; the result is
+ * identical to the serial conversion.
+ *
+ * With ConversionPrecision::Single the per-vertex work runs in float on
+ * twice as many SIMD lanes and writes half the bytes; the transform itself
+ * is still composed in double. Custom projections always convert in double.
+ * Vertices count as unprojectable below kMinDenominator<float> (1e-6)
+ * instead of the double threshold 1e-12.
+ *
+ * With incrementalRotation an angle-only rotator edit converts from the
+ * coordinates kept by SceneObject::rotatedCoords(), which leaves only the
+ * projection, scale and offset (a diagonal transform) to apply per vertex.
+ * The result matches the full conversion up to rounding.
+ */
+struct ConversionOptions {
+    bool                parallel            = true;
+    std::size_t         minParallelVertices = 32768;
+    std::size_t         grainSize           = 4096;
+    ConversionPrecision precision           = ConversionPrecision::Double;
+    bool                incrementalRotation = true;
+};
+
+/**
+ * @brief Deviation of single-precision conversion from double on a scene.
+ *
+ * Errors are measured over the vertices valid in both conversions;
+ * the relative error divides by max(1, |double result|).
+ */
+struct PrecisionReport {
+    std::size_t objects            = 0;
+    std::size_t vertices           = 0;
+    std::size_t validityMismatches = 0;   ///< vertices valid in only one precision
+    double      maxAbsError        = 0.0;
+    double      maxRelError        = 0.0;
+    QUuid       worstObject;              ///< object with the largest relative error
+};
+
+/// Hit and miss counts of the Scene conversion cache.
+struct ConversionCacheStats {
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
 };
 
 /**
@@ -56,6 +258,9 @@ struct ConvertedData {
  * The conversion applies stored rotations, projection, scaling, and offset transformations.
  *
  * The target dimension (default 3) can be set and retrieved.
+ *
+ * Conversions are cached per object, keyed by the object's versions and
+ * the scene dimension, so converting an unchanged object again is free.
  */
 class Scene {
 public:
@@ -80,7 +285,14 @@ public:
     /// Retrieves the scene object with the given uid.
     std::weak_ptr<SceneObject> getObject(const QUuid& uid) const;
 
-    /// Updates the scene object with the specified uid.
+    /**
+     * @brief Updates the scene object with the specified uid.
+     *
+     * Bumps the version of every field that actually changes. A shape
+     * counts as unchanged while it shares its buffers with the current one
+     * (an unedited clone), a built-in projection while its kernelParams()
+     * are equal; custom projections are compared by pointer.
+     */
     void setObject(const QUuid&               uid,
                    QString                    name,
                    std::shared_ptr<NDShape>   shape,
@@ -95,21 +307,108 @@ public:
     /// Returns the number of objects currently in the scene.
     std::size_t objectCount() const;
 
-    /// Performs full conversion on the given object.
-    static ConvertedData convertObject(const SceneObject& obj, int sceneDimension);
+    /**
+     * @brief Performs full conversion on the given object.
+     *
+     * With a built-in projection the whole conversion is one homogeneous
+     * matrix (transformMatrix()) applied to all vertices, followed by the
+     * projective divide; other projections fall back to convertObjectStaged(). After an
+     * angle-only rotator edit it starts from SceneObject::rotatedCoords() instead (see
+     * ConversionOptions::incrementalRotation). Large objects are
+     * split across threads as described by @p options.
+     *
+     * Vertices whose projection is undefined do not abort the conversion:
+     * they are flagged invalid, their edges are dropped, and one warning
+     * with the count is logged.
+     */
+    static ConvertedData convertObject(const SceneObject& obj, int sceneDimension,
+                                       const ConversionOptions& options = {});
 
-    /// Converts the NDShape for the scene object identified by the given uid.
-    ConvertedData convertObject(const QUuid& uid) const;
+    /**
+     * @brief convertObject() in single precision, straight into caller memory.
+     *
+     * The conversion kernel stores vertex k as float x, y, z at
+     * @p positions + k·@p stride, so the rows can land in an interleaved
+     * upload buffer without a further copy; the floats in between are left
+     * untouched. Missing axes are written as 0. The returned data carries
+     * everything but the coordinates: coords and coordsSingle stay empty.
+     *
+     * Custom projections and scene dimensions above three convert as usual
+     * and are narrowed with ConvertedData::writeFloat3().
+     *
+     * @param positions Room for vertexIds().size() rows of @p stride floats.
+     * @throws std::invalid_argument If @p positions is null or @p stride is below 3.
+     */
+    static ConvertedData convertObject(const SceneObject& obj, int sceneDimension,
+                                       const ConversionOptions& options,
+                                       float* positions, std::size_t stride);
+
+    /**
+     * @brief Reference conversion that materialises every stage as a shape.
+     *
+     * Matches convertObject() up to rounding, not bit for bit; kept for
+     * custom projections and as the baseline in tests and benchmarks.
+     * Unlike convertObject() it throws if a vertex cannot be projected.
+     * Both check only the combined denominator of a built-in projection
+     * (see HomogeneousTransform), so neither is bit-identical to, nor as
+     * strict as, calling Projection::projectShape() once per dimension.
+     */
+    static ConvertedData convertObjectStaged(const SceneObject& obj, int sceneDimension);
+
+    /**
+     * @brief Converts the NDShape for the scene object identified by the given uid.
+     *
+     * Returns the cached result while the object's versions and the scene
+     * dimension are unchanged.
+     */
+    std::shared_ptr<const ConvertedData> convertObject(const QUuid& uid) const;
 
-    /// Converts all stored NDShapes.
-    std::vector<ConvertedData> convertAllObjects() const;
+    /**
+     * @brief Converts all stored NDShapes, in object order.
+     *
+     * Objects missing from the cache are converted in parallel on the
+     * global QThreadPool, largest first; the calling thread takes part.
+     * Like every other Scene method, call it from one thread at a time.
+     */
+    std::vector<std::shared_ptr<const ConvertedData>> convertAllObjects() const;
 
     void            setSceneDimension(std::size_t dim);
     std::size_t     getSceneDimension() const;
 
+    /// Options used by convertObject(uid) and convertAllObjects().
+    void                     setConversionOptions(const ConversionOptions& options);
+    const ConversionOptions& conversionOptions() const;
+
+    /**
+     * @brief Converts every object in single and in double precision and
+     *        reports how far the single-precision results deviate.
+     *
+     * Bypasses the conversion cache; the result is also logged.
+     */
+    PrecisionReport checkSinglePrecision() const;
+
+    /// Conversion cache counters since construction or the last reset.
+    ConversionCacheStats conversionCacheStats() const;
+    void                 resetConversionCacheStats();
+
 private:
+    struct CachedConversion {
+        SceneObjectVersions                  versions;
+        std::size_t                          sceneDimension = 0;
+        std::shared_ptr<const ConvertedData> data;
+    };
+
+    /// Both convertObject() overloads; rows go to @p positions when it is set.
+    static ConvertedData convertObjectTo(const SceneObject& obj, int sceneDimension,
+                                         const ConversionOptions& options,
+                                         float* positions, std::size_t stride);
+
     std::vector<std::shared_ptr<SceneObject>> objects_;
     std::size_t                               sceneDimension_ = 3;
+    ConversionOptions                         conversionOptions_;
+
+    mutable std::unordered_map<QUuid, CachedConversion, UidHash> conversionCache_;
+    mutable ConversionCacheStats                                 cacheStats_;
 };
 
 #endif // SCENE_H
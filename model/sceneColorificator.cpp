@@ -15,9 +15,7 @@ ColoredVertexIterator::ColoredVertexIterator(const Scene* scene,
 {
     if (scene_ && objIndex_ < scene_->getAllObjects().size()) {
         loadCurrentConversion();
-        if (currentConv_.vertices.empty()) {
-            advanceToNext();
-        }
+        skipToValidVertex();
     }
 }
 
@@ -34,24 +32,34 @@ void ColoredVertexIterator::loadCurrentConversion()
 
 void ColoredVertexIterator::advanceToNext()
 {
-    const auto& objs = scene_->getAllObjects();
     ++vertexIndex_;
-    while (objIndex_ < objs.size() && vertexIndex_ >= currentConv_.vertices.size()) {
-        ++objIndex_;
-        vertexIndex_ = 0;
-        if (objIndex_ < objs.size()) loadCurrentConversion();
+    skipToValidVertex();
+}
+
+void ColoredVertexIterator::skipToValidVertex()
+{
+    const auto& objs = scene_->getAllObjects();
+    while (objIndex_ < objs.size()) {
+        if (vertexIndex_ < currentConv_->vertexCount()) {
+            if (currentConv_->isValid(vertexIndex_)) return;
+            ++vertexIndex_;
+        } else {
+            ++objIndex_;
+            vertexIndex_ = 0;
+            if (objIndex_ < objs.size()) loadCurrentConversion();
+        }
     }
 }
 
 ColoredVertexIterator::value_type ColoredVertexIterator::operator*() const
 {
     const auto& objs = scene_->getAllObjects();
-    if (objIndex_ >= objs.size() || vertexIndex_ >= currentConv_.vertices.size())
+    if (objIndex_ >= objs.size() || vertexIndex_ >= currentConv_->vertexCount())
         throw std::out_of_range("ColoredVertexIterator dereference out of range");
 
     ColoredVertex cv;
-    cv.coords = currentConv_.vertices[vertexIndex_].second;
-    cv.color  = colorificator_->getColorForObject(currentConv_.objectUid);
+    cv.coords = currentConv_->rowVector(vertexIndex_);
+    cv.color  = colorificator_->getColorForObject(currentConv_->objectUid);
     return cv;
 }
 
@@ -77,7 +85,7 @@ ColoredEdgeIterator::ColoredEdgeIterator(const Scene* scene,
 {
     if (scene_ && objIndex_ < scene_->getAllObjects().size()){
         loadCurrentConversion();
-        if (currentConv_.edges.empty()) {
+        if (currentConv_->edges.empty()) {
             advanceToNext();
         }
     }
@@ -98,7 +106,7 @@ void ColoredEdgeIterator::advanceToNext()
 {
     const auto& objs = scene_->getAllObjects();
     ++edgeIndex_;
-    while (objIndex_ < objs.size() && edgeIndex_ >= currentConv_.edges.size()) {
+    while (objIndex_ < objs.size() && edgeIndex_ >= currentConv_->edges.size()) {
         ++objIndex_;
         edgeIndex_ = 0;
         if (objIndex_ < objs.size()) loadCurrentConversion();
@@ -108,18 +116,16 @@ void ColoredEdgeIterator::advanceToNext()
 ColoredEdgeIterator::value_type ColoredEdgeIterator::operator*() const
 {
     const auto& objs = scene_->getAllObjects();
-    if (objIndex_ >= objs.size() || edgeIndex_ >= currentConv_.edges.size())
+    if (objIndex_ >= objs.size() || edgeIndex_ >= currentConv_->edges.size())
         throw std::out_of_range("ColoredEdgeIterator dereference out of range");
 
     ColoredLine cl;
-    auto id1 = currentConv_.edges[edgeIndex_].first;
-    auto id2 = currentConv_.edges[edgeIndex_].second;
+    auto id1 = currentConv_->edges[edgeIndex_].first;
+    auto id2 = currentConv_->edges[edgeIndex_].second;
 
-    for (const auto& v : currentConv_.vertices) {
-        if (v.first == id1) cl.start = v.second;
-        if (v.first == id2) cl.end   = v.second;
-    }
-    cl.color = colorificator_->getColorForObject(currentConv_.objectUid);
+    cl.start = currentConv_->rowVector(currentConv_->rowOf(id1));
+    cl.end   = currentConv_->rowVector(currentConv_->rowOf(id2));
+    cl.color = colorificator_->getColorForObject(currentConv_->objectUid);
     return cl;
 }
 
@@ -155,6 +161,7 @@ QColor SceneColorificator::getColorForObject(const QUuid& uid) const
 
 SceneColorificator::VertexIterator SceneColorificator::beginVertices(const Scene& scene) const
 {
+    scene.convertAllObjects();   // converts stale objects in parallel; the iterator then hits the cache
     return { &scene, this, 0, 0 };
 }
 SceneColorificator::VertexIterator SceneColorificator::endVertices(const Scene& scene) const
@@ -164,6 +171,7 @@ SceneColorificator::VertexIterator SceneColorificator::endVertices(const Scene&
 
 SceneColorificator::EdgeIterator SceneColorificator::beginEdges(const Scene& scene) const
 {
+    scene.convertAllObjects();
     return { &scene, this, 0, 0 };
 }
 SceneColorificator::EdgeIterator SceneColorificator::endEdges(const Scene& scene) const
@@ -8,12 +8,6 @@
 #include <QUuid>
 #include "scene.h"
 
-/* ---------- helpers ------------------------------------------------------ */
-struct UidHash {
-    std::size_t operator()(const QUuid& uid) const noexcept { return qHash(uid); }
-};
-/* ------------------------------------------------------------------------- */
-
 /* ---------- coloured primitives ----------------------------------------- */
 struct ColoredVertex {
     std::vector<double> coords;
@@ -51,10 +45,12 @@ private:
     const SceneColorificator*   colorificator_;
     std::size_t                 objIndex_;
     std::size_t                 vertexIndex_;
-    ConvertedData               currentConv_;
+    std::shared_ptr<const ConvertedData> currentConv_;
 
     void loadCurrentConversion();
     void advanceToNext();
+    /// Moves forward to the next vertex that projected successfully.
+    void skipToValidVertex();
 };
 
 class ColoredEdgeIterator {
@@ -78,7 +74,7 @@ private:
     const SceneColorificator*  colorificator_;
     std::size_t                objIndex_;
     std::size_t                edgeIndex_;
-    ConvertedData              currentConv_;
+    std::shared_ptr<const ConvertedData> currentConv_;
 
     void loadCurrentConversion();
     void advanceToNext();
@@ -0,0 +1,55 @@
+#include "simdKernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+SimdLevel queryCpu()
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return SimdLevel::SSE41;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse41   = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+
+    // AVX state must also be enabled by the OS (XCR0 bits 1 and 2)
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    if (avx2)
+        return SimdLevel::AVX2;
+    if (sse41)
+        return SimdLevel::SSE41;
+#endif
+    return SimdLevel::Scalar;
+}
+} // namespace
+
+SimdLevel detectSimdLevel()
+{
+    static const SimdLevel level = queryCpu();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::AVX2:  return "AVX2";
+    case SimdLevel::SSE41: return "SSE4.1";
+    default:               return "Scalar";
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include "geometryKernels.h"
+
+/**
+ * @brief Instruction set tiers of the geometry kernels, in ascending order.
+ *
+ * The vector tiers exist on x86 only; every other target (ARM64 builds
+ * included) runs the scalar Kernels<N>.
+ */
+enum class SimdLevel { Scalar, SSE41, AVX2 };
+
+/// Best tier supported by this CPU; queried once via CPUID.
+SimdLevel detectSimdLevel();
+
+/// Human-readable tier name, e.g. "AVX2".
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief kernelsFor() restricted to the given tier.
+ *
+ * Tiers above detectSimdLevel() fall back to the best supported one.
+ * Meant for tests and benchmarks; everything else calls kernelsFor(dim).
+ */
+const KernelTable& kernelsFor(std::size_t dim, SimdLevel level);
+
+/*
+ * Vector entry points installed into the KernelTable by kernelsFor().
+ *
+ * They process blocks of 2 (SSE4.1) or 4 (AVX2) vertices at once, twice
+ * as many in single precision. The row-major entries transpose each block
+ * into a dimension-major tile, so every arithmetic instruction works on
+ * the same coordinate of several vertices; rotateColumns() and
+ * convertDiagonal() read the dimension-major columns of the rotated
+ * coordinate cache directly and need no transpose. The
+ * per-lane arithmetic is the scalar one without contraction, so results
+ * are bit-identical to Kernels<N>. convertHomogeneous() supports dimensions up
+ * to kMaxKernelDimension only. Each tier lives in its own translation
+ * unit compiled for that instruction set.
+ */
+namespace simd {
+namespace sse41 {
+void rotatePlane(double* rows, std::size_t count, std::size_t dim,
+                 std::size_t a1, std::size_t a2, double cosA, double sinA);
+bool projectPerspective(const double* in, double* out, std::size_t count,
+                        std::size_t dim, double d);
+bool projectStereographic(const double* in, double* out, std::size_t count,
+                          std::size_t dim);
+std::size_t convertHomogeneous(const double* in, double* out, std::size_t count,
+                               std::size_t dim, std::size_t targetDim,
+                               const double* m, bool divide, unsigned char* valid);
+std::size_t convertHomogeneousSingle(const double* in, float* out, std::size_t count,
+                                     std::size_t dim, std::size_t targetDim,
+                                     const float* m, bool divide, unsigned char* valid,
+                                     std::size_t outStride);
+void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                   std::size_t count, double cosA, double sinA);
+std::size_t convertDiagonal(const double* const* columns, double* out, std::size_t count,
+                            std::size_t dim, std::size_t targetDim,
+                            const double* m, const double* offset, bool divide,
+                            unsigned char* valid);
+std::size_t convertDiagonalSingle(const double* const* columns, float* out, std::size_t count,
+                                  std::size_t dim, std::size_t targetDim,
+                                  const float* m, const float* offset, bool divide,
+                                  unsigned char* valid, std::size_t outStride);
+} // namespace sse41
+
+namespace avx2 {
+void rotatePlane(double* rows, std::size_t count, std::size_t dim,
+                 std::size_t a1, std::size_t a2, double cosA, double sinA);
+bool projectPerspective(const double* in, double* out, std::size_t count,
+                        std::size_t dim, double d);
+bool projectStereographic(const double* in, double* out, std::size_t count,
+                          std::size_t dim);
+std::size_t convertHomogeneous(const double* in, double* out, std::size_t count,
+                               std::size_t dim, std::size_t targetDim,
+                               const double* m, bool divide, unsigned char* valid);
+std::size_t convertHomogeneousSingle(const double* in, float* out, std::size_t count,
+                                     std::size_t dim, std::size_t targetDim,
+                                     const float* m, bool divide, unsigned char* valid,
+                                     std::size_t outStride);
+void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                   std::size_t count, double cosA, double sinA);
+std::size_t convertDiagonal(const double* const* columns, double* out, std::size_t count,
+                            std::size_t dim, std::size_t targetDim,
+                            const double* m, const double* offset, bool divide,
+                            unsigned char* valid);
+std::size_t convertDiagonalSingle(const double* const* columns, float* out, std::size_t count,
+                                  std::size_t dim, std::size_t targetDim,
+                                  const float* m, const float* offset, bool divide,
+                                  unsigned char* valid, std::size_t outStride);
+} // namespace avx2
+} // namespace simd
+
+#endif // SIMD_KERNELS_H
@@ -0,0 +1,202 @@
+#include "simdKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+/// Four doubles in one AVX register.
+struct Vec {
+    using Scalar = double;
+    static constexpr std::size_t width = 4;
+    __m256d v;
+
+    static Vec broadcast(double x) { return { _mm256_set1_pd(x) }; }
+
+    static Vec gather(const double* p, std::size_t stride, std::size_t lanes)
+    {
+        if (lanes == 4)
+            return { _mm256_set_pd(p[3 * stride], p[2 * stride], p[stride], p[0]) };
+        double t[4];
+        for (std::size_t l = 0; l < 4; ++l)
+            t[l] = p[(l < lanes ? l : lanes - 1) * stride];
+        return { _mm256_loadu_pd(t) };
+    }
+
+    static Vec load(const double* p, std::size_t lanes)
+    {
+        return lanes == 4 ? Vec{ _mm256_loadu_pd(p) } : gather(p, 1, lanes);
+    }
+
+    void scatter(double* p, std::size_t stride, std::size_t lanes) const
+    {
+        if (lanes == 4) {
+            const __m128d lo = _mm256_castpd256_pd128(v);
+            const __m128d hi = _mm256_extractf128_pd(v, 1);
+            _mm_storel_pd(p, lo);
+            _mm_storeh_pd(p + stride, lo);
+            _mm_storel_pd(p + 2 * stride, hi);
+            _mm_storeh_pd(p + 3 * stride, hi);
+            return;
+        }
+        double t[4];
+        _mm256_storeu_pd(t, v);
+        for (std::size_t l = 0; l < lanes; ++l)
+            p[l * stride] = t[l];
+    }
+
+    void store(double* p, std::size_t lanes) const
+    {
+        if (lanes == 4)
+            _mm256_storeu_pd(p, v);
+        else
+            scatter(p, 1, lanes);
+    }
+
+    static int notAtLeast(Vec a, double b)
+    {
+        const __m256d absA = _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v);
+        return _mm256_movemask_pd(_mm256_cmp_pd(absA, _mm256_set1_pd(b), _CMP_NGE_UQ));
+    }
+};
+
+Vec operator+(Vec a, Vec b) { return { _mm256_add_pd(a.v, b.v) }; }
+Vec operator-(Vec a, Vec b) { return { _mm256_sub_pd(a.v, b.v) }; }
+Vec operator*(Vec a, Vec b) { return { _mm256_mul_pd(a.v, b.v) }; }
+Vec operator/(Vec a, Vec b) { return { _mm256_div_pd(a.v, b.v) }; }
+
+/// Eight floats in one AVX register; loads round doubles to float.
+struct VecF {
+    using Scalar = float;
+    static constexpr std::size_t width = 8;
+    __m256 v;
+
+    static VecF broadcast(float x) { return { _mm256_set1_ps(x) }; }
+
+    static VecF gather(const double* p, std::size_t stride, std::size_t lanes)
+    {
+        float t[8];
+        for (std::size_t l = 0; l < 8; ++l)
+            t[l] = static_cast<float>(p[(l < lanes ? l : lanes - 1) * stride]);
+        return { _mm256_loadu_ps(t) };
+    }
+
+    static VecF load(const double* p, std::size_t lanes)
+    {
+        if (lanes == 8) {
+            const __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(p));
+            const __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(p + 4));
+            return { _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1) };
+        }
+        return gather(p, 1, lanes);
+    }
+
+    void scatter(float* p, std::size_t stride, std::size_t lanes) const
+    {
+        if (lanes == 8) {
+            for (int half = 0; half < 2; ++half, p += 4 * stride) {
+                const __m128 q = half ? _mm256_extractf128_ps(v, 1) : _mm256_castps256_ps128(v);
+                _mm_store_ss(p, q);
+                _mm_store_ss(p + stride, _mm_shuffle_ps(q, q, 1));
+                _mm_store_ss(p + 2 * stride, _mm_shuffle_ps(q, q, 2));
+                _mm_store_ss(p + 3 * stride, _mm_shuffle_ps(q, q, 3));
+            }
+            return;
+        }
+        float t[8];
+        _mm256_storeu_ps(t, v);
+        for (std::size_t l = 0; l < lanes; ++l)
+            p[l * stride] = t[l];
+    }
+
+    static int notAtLeast(VecF a, float b)
+    {
+        const __m256 absA = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v);
+        return _mm256_movemask_ps(_mm256_cmp_ps(absA, _mm256_set1_ps(b), _CMP_NGE_UQ));
+    }
+};
+
+VecF operator+(VecF a, VecF b) { return { _mm256_add_ps(a.v, b.v) }; }
+VecF operator*(VecF a, VecF b) { return { _mm256_mul_ps(a.v, b.v) }; }
+VecF operator/(VecF a, VecF b) { return { _mm256_div_ps(a.v, b.v) }; }
+
+#include "simdKernelsImpl.h"
+using Impl  = SimdKernels<Vec>;
+using ImplF = SimdKernels<VecF>;
+} // namespace
+
+namespace simd {
+namespace avx2 {
+void rotatePlane(double* rows, std::size_t count, std::size_t dim,
+                 std::size_t a1, std::size_t a2, double cosA, double sinA)
+{
+    Impl::rotatePlane(rows, count, dim, a1, a2, cosA, sinA);
+}
+
+bool projectPerspective(const double* in, double* out, std::size_t count,
+                        std::size_t dim, double d)
+{
+    return Impl::projectPerspective(in, out, count, dim, d);
+}
+
+bool projectStereographic(const double* in, double* out, std::size_t count,
+                          std::size_t dim)
+{
+    return Impl::projectStereographic(in, out, count, dim);
+}
+
+std::size_t convertHomogeneous(const double* in, double* out, std::size_t count,
+                               std::size_t dim, std::size_t targetDim,
+                               const double* m, bool divide, unsigned char* valid)
+{
+    return Impl::convertHomogeneous(in, out, count, dim, targetDim, m, divide, valid, targetDim);
+}
+
+std::size_t convertHomogeneousSingle(const double* in, float* out, std::size_t count,
+                                     std::size_t dim, std::size_t targetDim,
+                                     const float* m, bool divide, unsigned char* valid,
+                                     std::size_t outStride)
+{
+    return ImplF::convertHomogeneous(in, out, count, dim, targetDim, m, divide, valid, outStride);
+}
+
+void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                   std::size_t count, double cosA, double sinA)
+{
+    Impl::rotateColumns(x, y, outX, outY, count, cosA, sinA);
+}
+
+std::size_t convertDiagonal(const double* const* columns, double* out, std::size_t count,
+                            std::size_t dim, std::size_t targetDim,
+                            const double* m, const double* offset, bool divide,
+                            unsigned char* valid)
+{
+    return Impl::convertDiagonal(columns, out, count, dim, targetDim, m, offset, divide, valid,
+                                 targetDim);
+}
+
+std::size_t convertDiagonalSingle(const double* const* columns, float* out, std::size_t count,
+                                  std::size_t dim, std::size_t targetDim,
+                                  const float* m, const float* offset, bool divide,
+                                  unsigned char* valid, std::size_t outStride)
+{
+    return ImplF::convertDiagonal(columns, out, count, dim, targetDim, m, offset, divide, valid,
+                                  outStride);
+}
+} // namespace avx2
+} // namespace simd
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // x86
@@ -0,0 +1,185 @@
+#ifndef SIMD_KERNELS_IMPL_H
+#define SIMD_KERNELS_IMPL_H
+
+/*
+ * Vector kernel bodies shared by the per-ISA translation units.
+ *
+ * Include this only inside a region compiled for the target instruction
+ * set, after defining a lane type with:
+ *   Scalar, width, broadcast(x), gather(p, stride, lanes), load(p, lanes),
+ *   scatter(p, stride, lanes), + - * /, and notAtLeast(a, b) returning a
+ *   lane bitmask of !(|a| >= b); double lane types also need store(p, lanes).
+ * gather() and load() always read doubles and round them to Scalar; they
+ * fill the lanes past `lanes` with copies of the last valid lane, so a
+ * partial tail block can never raise a spurious division by zero. Float
+ * lane types only support convertHomogeneous() and convertDiagonal().
+ * Nothing here may instantiate standard library templates: they would be
+ * compiled for the target ISA and could be picked by the linker for the
+ * whole program.
+ */
+
+template<class V>
+struct SimdKernels {
+    using Scalar = typename V::Scalar;
+    static constexpr std::size_t W = V::width;
+
+    static std::size_t lanesAt(std::size_t v, std::size_t count)
+    {
+        return count - v < W ? count - v : W;
+    }
+
+    static void rotatePlane(double* rows, std::size_t count, std::size_t dim,
+                            std::size_t a1, std::size_t a2, double cosA, double sinA)
+    {
+        const V c = V::broadcast(cosA);
+        const V s = V::broadcast(sinA);
+        for (std::size_t v = 0; v < count; v += W, rows += W * dim) {
+            const std::size_t lanes = lanesAt(v, count);
+            const V x = V::gather(rows + a1, dim, lanes);
+            const V y = V::gather(rows + a2, dim, lanes);
+            (x * c - y * s).scatter(rows + a1, dim, lanes);
+            (x * s + y * c).scatter(rows + a2, dim, lanes);
+        }
+    }
+
+    static bool projectPerspective(const double* in, double* out, std::size_t count,
+                                   std::size_t dim, double d)
+    {
+        const V vd = V::broadcast(d);
+        int bad = 0;
+        for (std::size_t v = 0; v < count; v += W, in += W * dim, out += W * (dim - 1)) {
+            const std::size_t lanes = lanesAt(v, count);
+            const V den = V::gather(in + dim - 1, dim, lanes) + vd;
+            const V k = vd / den;
+            bad |= V::notAtLeast(den, kEpsilon);
+            for (std::size_t i = 0; i + 1 < dim; ++i)
+                (V::gather(in + i, dim, lanes) * k).scatter(out + i, dim - 1, lanes);
+        }
+        return bad == 0;
+    }
+
+    static bool projectStereographic(const double* in, double* out, std::size_t count,
+                                     std::size_t dim)
+    {
+        const V one = V::broadcast(1.0);
+        int bad = 0;
+        for (std::size_t v = 0; v < count; v += W, in += W * dim, out += W * (dim - 1)) {
+            const std::size_t lanes = lanesAt(v, count);
+            const V den = one - V::gather(in + dim - 1, dim, lanes);
+            const V k = one / den;
+            bad |= V::notAtLeast(den, kEpsilon);
+            for (std::size_t i = 0; i + 1 < dim; ++i)
+                (V::gather(in + i, dim, lanes) * k).scatter(out + i, dim - 1, lanes);
+        }
+        return bad == 0;
+    }
+
+    /// One block of W rows times a (dim+1)×(dim+1) homogeneous matrix, GEMM style:
+    /// every matrix entry is broadcast once per block and applied to W vertices.
+    /// Output rows are @p outStride values apart.
+    static std::size_t convertHomogeneous(const double* in, Scalar* out, std::size_t count,
+                                          std::size_t dim, std::size_t targetDim,
+                                          const Scalar* m, bool divide, unsigned char* valid,
+                                          std::size_t outStride)
+    {
+        const std::size_t n = dim;
+        V x[kMaxKernelDimension];
+
+        std::size_t invalid = 0;
+        for (std::size_t v = 0; v < count; v += W, in += W * n, out += W * outStride) {
+            const std::size_t lanes = lanesAt(v, count);
+            for (std::size_t j = 0; j < n; ++j)
+                x[j] = V::gather(in + j, n, lanes);
+
+            int bad = 0;
+            if (divide) {
+                const V w = row(m + n * (n + 1), x, n);
+                bad = V::notAtLeast(w, kEpsilon);
+                for (std::size_t i = 0; i < targetDim; ++i)
+                    (row(m + i * (n + 1), x, n) / w).scatter(out + i, outStride, lanes);
+            } else {
+                for (std::size_t i = 0; i < targetDim; ++i)
+                    row(m + i * (n + 1), x, n).scatter(out + i, outStride, lanes);
+            }
+
+            for (std::size_t l = 0; l < lanes; ++l) {
+                const bool ok = ((bad >> l) & 1) == 0;
+                invalid += !ok;
+                if (valid)
+                    valid[v + l] = ok;
+            }
+        }
+        return invalid;
+    }
+
+    /// ::rotateColumns() on dimension-major columns, W coordinates per load.
+    static void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                              std::size_t count, double cosA, double sinA)
+    {
+        const V c = V::broadcast(cosA);
+        const V s = V::broadcast(sinA);
+        for (std::size_t v = 0; v < count; v += W) {
+            const std::size_t lanes = lanesAt(v, count);
+            const V vx = V::load(x + v, lanes);
+            const V vy = V::load(y + v, lanes);
+            (vx * c - vy * s).store(outX + v, lanes);
+            (vx * s + vy * c).store(outY + v, lanes);
+        }
+    }
+
+    /// ::convertDiagonal() on dimension-major columns: the columns already
+    /// are the SoA tile, so every coordinate is one contiguous load and only
+    /// the interleaved output is scattered.
+    static std::size_t convertDiagonal(const double* const* columns, Scalar* out,
+                                       std::size_t count, std::size_t dim,
+                                       std::size_t targetDim, const Scalar* m,
+                                       const Scalar* offset, bool divide,
+                                       unsigned char* valid, std::size_t outStride)
+    {
+        const std::size_t n = dim;
+        const Scalar* wRow = m + n * (n + 1);
+        const V one = V::broadcast(Scalar(1));
+
+        std::size_t invalid = 0;
+        for (std::size_t v = 0; v < count; v += W, out += W * outStride) {
+            const std::size_t lanes = lanesAt(v, count);
+            V w = one;
+            int bad = 0;
+            if (divide) {
+                w = V::broadcast(wRow[n]);
+                for (std::size_t j = targetDim; j < n; ++j)
+                    w = w + V::broadcast(wRow[j]) * V::load(columns[j] + v, lanes);
+                bad = V::notAtLeast(w, kEpsilon);
+                w = one / w;
+            }
+            for (std::size_t i = 0; i < targetDim; ++i) {
+                const V d = V::broadcast(m[i * (n + 2)]);
+                const V o = V::broadcast(offset ? offset[i] : Scalar(0));
+                (d * V::load(columns[i] + v, lanes) * w + o).scatter(out + i, outStride, lanes);
+            }
+
+            for (std::size_t l = 0; l < lanes; ++l) {
+                const bool ok = ((bad >> l) & 1) == 0;
+                invalid += !ok;
+                if (valid)
+                    valid[v + l] = ok;
+            }
+        }
+        return invalid;
+    }
+
+private:
+    /// Same threshold as the scalar kernels, per lane precision.
+    static constexpr Scalar kEpsilon = kMinDenominator<Scalar>;
+
+    /// Kernels<N>::homogeneousRow() for W vertices at once.
+    static V row(const Scalar* r, const V* x, std::size_t n)
+    {
+        V acc = V::broadcast(Scalar(0));
+        for (std::size_t j = 0; j < n; ++j)
+            acc = acc + V::broadcast(r[j]) * x[j];
+        return acc + V::broadcast(r[n]);
+    }
+};
+
+#endif // SIMD_KERNELS_IMPL_H
@@ -0,0 +1,181 @@
+#include "simdKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse4.1"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+namespace {
+/// Two doubles in one SSE register.
+struct Vec {
+    using Scalar = double;
+    static constexpr std::size_t width = 2;
+    __m128d v;
+
+    static Vec broadcast(double x) { return { _mm_set1_pd(x) }; }
+
+    static Vec gather(const double* p, std::size_t stride, std::size_t lanes)
+    {
+        return { _mm_set_pd(p[(lanes == 2 ? 1 : 0) * stride], p[0]) };
+    }
+
+    static Vec load(const double* p, std::size_t lanes)
+    {
+        return { lanes == 2 ? _mm_loadu_pd(p) : _mm_set1_pd(p[0]) };
+    }
+
+    void scatter(double* p, std::size_t stride, std::size_t lanes) const
+    {
+        _mm_storel_pd(p, v);
+        if (lanes == 2)
+            _mm_storeh_pd(p + stride, v);
+    }
+
+    void store(double* p, std::size_t lanes) const
+    {
+        if (lanes == 2)
+            _mm_storeu_pd(p, v);
+        else
+            _mm_storel_pd(p, v);
+    }
+
+    static int notAtLeast(Vec a, double b)
+    {
+        const __m128d absA = _mm_andnot_pd(_mm_set1_pd(-0.0), a.v);
+        return _mm_movemask_pd(_mm_cmpnge_pd(absA, _mm_set1_pd(b)));
+    }
+};
+
+Vec operator+(Vec a, Vec b) { return { _mm_add_pd(a.v, b.v) }; }
+Vec operator-(Vec a, Vec b) { return { _mm_sub_pd(a.v, b.v) }; }
+Vec operator*(Vec a, Vec b) { return { _mm_mul_pd(a.v, b.v) }; }
+Vec operator/(Vec a, Vec b) { return { _mm_div_pd(a.v, b.v) }; }
+
+/// Four floats in one SSE register; loads round doubles to float.
+struct VecF {
+    using Scalar = float;
+    static constexpr std::size_t width = 4;
+    __m128 v;
+
+    static VecF broadcast(float x) { return { _mm_set1_ps(x) }; }
+
+    static VecF gather(const double* p, std::size_t stride, std::size_t lanes)
+    {
+        float t[4];
+        for (std::size_t l = 0; l < 4; ++l)
+            t[l] = static_cast<float>(p[(l < lanes ? l : lanes - 1) * stride]);
+        return { _mm_loadu_ps(t) };
+    }
+
+    static VecF load(const double* p, std::size_t lanes)
+    {
+        if (lanes == 4)
+            return { _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(p)), _mm_cvtpd_ps(_mm_loadu_pd(p + 2))) };
+        return gather(p, 1, lanes);
+    }
+
+    void scatter(float* p, std::size_t stride, std::size_t lanes) const
+    {
+        if (lanes == 4) {
+            _mm_store_ss(p, v);
+            _mm_store_ss(p + stride, _mm_shuffle_ps(v, v, 1));
+            _mm_store_ss(p + 2 * stride, _mm_shuffle_ps(v, v, 2));
+            _mm_store_ss(p + 3 * stride, _mm_shuffle_ps(v, v, 3));
+            return;
+        }
+        float t[4];
+        _mm_storeu_ps(t, v);
+        for (std::size_t l = 0; l < lanes; ++l)
+            p[l * stride] = t[l];
+    }
+
+    static int notAtLeast(VecF a, float b)
+    {
+        const __m128 absA = _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v);
+        return _mm_movemask_ps(_mm_cmpnge_ps(absA, _mm_set1_ps(b)));
+    }
+};
+
+VecF operator+(VecF a, VecF b) { return { _mm_add_ps(a.v, b.v) }; }
+VecF operator*(VecF a, VecF b) { return { _mm_mul_ps(a.v, b.v) }; }
+VecF operator/(VecF a, VecF b) { return { _mm_div_ps(a.v, b.v) }; }
+
+#include "simdKernelsImpl.h"
+using Impl  = SimdKernels<Vec>;
+using ImplF = SimdKernels<VecF>;
+} // namespace
+
+namespace simd {
+namespace sse41 {
+void rotatePlane(double* rows, std::size_t count, std::size_t dim,
+                 std::size_t a1, std::size_t a2, double cosA, double sinA)
+{
+    Impl::rotatePlane(rows, count, dim, a1, a2, cosA, sinA);
+}
+
+bool projectPerspective(const double* in, double* out, std::size_t count,
+                        std::size_t dim, double d)
+{
+    return Impl::projectPerspective(in, out, count, dim, d);
+}
+
+bool projectStereographic(const double* in, double* out, std::size_t count,
+                          std::size_t dim)
+{
+    return Impl::projectStereographic(in, out, count, dim);
+}
+
+std::size_t convertHomogeneous(const double* in, double* out, std::size_t count,
+                               std::size_t dim, std::size_t targetDim,
+                               const double* m, bool divide, unsigned char* valid)
+{
+    return Impl::convertHomogeneous(in, out, count, dim, targetDim, m, divide, valid, targetDim);
+}
+
+std::size_t convertHomogeneousSingle(const double* in, float* out, std::size_t count,
+                                     std::size_t dim, std::size_t targetDim,
+                                     const float* m, bool divide, unsigned char* valid,
+                                     std::size_t outStride)
+{
+    return ImplF::convertHomogeneous(in, out, count, dim, targetDim, m, divide, valid, outStride);
+}
+
+void rotateColumns(const double* x, const double* y, double* outX, double* outY,
+                   std::size_t count, double cosA, double sinA)
+{
+    Impl::rotateColumns(x, y, outX, outY, count, cosA, sinA);
+}
+
+std::size_t convertDiagonal(const double* const* columns, double* out, std::size_t count,
+                            std::size_t dim, std::size_t targetDim,
+                            const double* m, const double* offset, bool divide,
+                            unsigned char* valid)
+{
+    return Impl::convertDiagonal(columns, out, count, dim, targetDim, m, offset, divide, valid,
+                                 targetDim);
+}
+
+std::size_t convertDiagonalSingle(const double* const* columns, float* out, std::size_t count,
+                                  std::size_t dim, std::size_t targetDim,
+                                  const float* m, const float* offset, bool divide,
+                                  unsigned char* valid, std::size_t outStride)
+{
+    return ImplF::convertDiagonal(columns, out, count, dim, targetDim, m, offset, divide, valid,
+                                  outStride);
+}
+} // namespace sse41
+} // namespace simd
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // x86
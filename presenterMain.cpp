@@ -250,6 +250,8 @@ void PresenterMainTab::markSaved(QString filePath)
 }
 
 // ----------------- PresenterMainTab save / load ------------------------
+bool PresenterMainTab::compactIdsOnSave = false;
+
 bool PresenterMainTab::save(bool saveAs, QWidget* parentWindow)
 {
     QString fn = filePath_;
@@ -270,6 +272,10 @@ bool PresenterMainTab::save(bool saveAs, QWidget* parentWindow)
                               QObject::tr("Cannot write to %1").arg(fn));
         return false;
     }
+    // renumber the open scene itself (undoably), so it matches the saved file
+    if (compactIdsOnSave)
+        tabWidget_->compactVertexIds();
+
     QJsonDocument doc = SceneSerializer::toJson(*scene_, *sceneColorificator_);
     f.write(doc.toJson(QJsonDocument::Indented)); f.close();
     markSaved(fn);
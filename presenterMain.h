@@ -87,6 +87,10 @@ public:
     void markDirty();
     void markSaved(QString filePath);
 
+    /// Renumber sparse vertex IDs densely on save and export
+    /// (config key "compactVertexIdsOnSave").
+    static bool compactIdsOnSave;
+
 private:
     void updateLabel();
 
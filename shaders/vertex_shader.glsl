@@ -15,6 +15,16 @@ layout(location = 1) in vec3 aNormal;
  */
 layout(location = 2) in vec3 aColor;
 
+/**
+ *  Per-instance position: the sphere centre, or the start of a tube.
+ */
+layout(location = 3) in vec3 aInstanceStart;
+
+/**
+ *  Per-instance end of a tube.
+ */
+layout(location = 4) in vec3 aInstanceEnd;
+
 /**
  *  Interpolated normal passed to the fragment shader.
  */
@@ -50,17 +60,50 @@ uniform mat4 uModelMatrix;
  */
 uniform mat4 uLightSpaceMatrix;
 
+/**
+ *  How aPosition is placed: 0 as is, 1 moved to aInstanceStart (spheres),
+ *  2 as a unit tube along z stretched from aInstanceStart to aInstanceEnd.
+ */
+uniform int uInstanceMode;
+
+/**
+ *  Places the mesh vertex for the current instance; also turns aNormal.
+ */
+vec3 instancePosition(out vec3 normal)
+{
+    normal = aNormal;
+    if (uInstanceMode == 1)
+        return aInstanceStart + aPosition;
+    if (uInstanceMode != 2)
+        return aPosition;
+
+    // same frame as the CPU-built tubes; a degenerate edge collapses to a point
+    vec3  axis   = aInstanceEnd - aInstanceStart;
+    float len    = length(axis);
+    vec3  dir    = len > 1e-6 ? axis / len : vec3(0.0, 0.0, 1.0);
+    vec3  up     = abs(dir.y) > 0.999 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);
+    vec3  perpX  = normalize(cross(dir, up));
+    vec3  perpY  = normalize(cross(dir, perpX));
+    float radial = len > 1e-6 ? 1.0 : 0.0;
+    normal = perpX * aNormal.x + perpY * aNormal.y + dir * aNormal.z;
+    return aInstanceStart + radial * (perpX * aPosition.x + perpY * aPosition.y)
+                          + axis * aPosition.z;
+}
+
 void main()
 {
     vColor = aColor;
 
-    vec4 worldPos = uModelMatrix * vec4(aPosition, 1.0);
+    vec3 normal;
+    vec3 position = instancePosition(normal);
+
+    vec4 worldPos = uModelMatrix * vec4(position, 1.0);
     vWorldPos     = worldPos.xyz;
 
     // Correct normal transform
-    vNormal = mat3(transpose(inverse(uModelMatrix))) * aNormal;
+    vNormal = mat3(transpose(inverse(uModelMatrix))) * normal;
 
-    gl_Position = uMvpMatrix * vec4(aPosition, 1.0);
+    gl_Position = uMvpMatrix * vec4(position, 1.0);
 
     // Light-space position (for shadow lookups)
     vShadowCoord = uLightSpaceMatrix * worldPos;
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../model/NDShape.h"
+#include <algorithm>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 
 class NDShapeTest : public ::testing::Test {
 protected:
@@ -105,6 +108,29 @@ TEST_F(NDShapeTest, AddMultipleVertices) {
     EXPECT_TRUE(foundId2);
 }
 
+/**
+ * @test addVertices() continues the ID sequence and leaves the topology
+ *       shared with an earlier copy.
+ */
+TEST_F(NDShapeTest, AddVerticesKeepsTopologyShared) {
+    std::size_t a = shape3D->addVertex({0, 0, 0});
+    std::size_t b = shape3D->addVertex({1, 0, 0});
+    shape3D->addEdge(a, b);
+
+    NDShape before = *shape3D;
+    const double flat[] = { 2, 0, 0,  3, 1, 0 };
+    EXPECT_EQ(shape3D->addVertices(flat, 2), 2U);
+
+    EXPECT_EQ(shape3D->getVertex(2), (std::vector<double>{2, 0, 0}));
+    EXPECT_EQ(shape3D->getVertex(3), (std::vector<double>{3, 1, 0}));
+    EXPECT_EQ(before.vertexIds().size(), 2U);
+    EXPECT_EQ(&shape3D->getEdges(), &before.getEdges());
+    EXPECT_EQ(shape3D->addVertex({0, 0, 1}), 4U);
+    shape3D->addEdge(3, 4);
+    EXPECT_TRUE(shape3D->hasEdge(a, b));
+    EXPECT_EQ(before.edgesSize(), 1);
+}
+
 /**
  * @test Add edge between two valid vertices.
  */
@@ -269,6 +295,32 @@ TEST_F(NDShapeTest, RemoveEdgeNonExisting) {
     }, std::out_of_range);
 }
 
+/**
+ * @test Single removals move the last edge into the freed position, batched
+ *       removals keep the order of the remaining edges.
+ */
+TEST_F(NDShapeTest, EdgeOrderAfterRemoval) {
+    using E = std::pair<std::size_t, std::size_t>;
+    for (int i = 0; i < 6; ++i) shape3D->addVertex({0,0,0});
+    shape3D->addEdge(0, 1);
+    shape3D->addEdge(1, 2);
+    shape3D->addEdge(2, 3);
+    shape3D->addEdge(3, 4);
+    shape3D->addEdge(4, 5);
+
+    NDShape batched = *shape3D;
+
+    shape3D->removeEdge(1, 2);
+    EXPECT_EQ(shape3D->getEdges(), (std::vector<E>{ {0, 1}, {4, 5}, {2, 3}, {3, 4} }));
+    shape3D->removeVertex(0);
+    EXPECT_EQ(shape3D->getEdges(), (std::vector<E>{ {3, 4}, {4, 5}, {2, 3} }));
+
+    batched.removeEdges({ {2, 1} });
+    EXPECT_EQ(batched.getEdges(), (std::vector<E>{ {0, 1}, {2, 3}, {3, 4}, {4, 5} }));
+    batched.removeVertices({ 0 });
+    EXPECT_EQ(batched.getEdges(), (std::vector<E>{ {2, 3}, {3, 4}, {4, 5} }));
+}
+
 /**
  * @test Retrieve the adjacency matrix.
  */
@@ -429,3 +481,338 @@ TEST_F(NDShapeTest, UpdateFromAdjacencyMatrixInvalidCellValue) {
         shape3D->updateFromAdjacencyMatrix(invalidMatrix);
     }, std::invalid_argument);
 }
+
+/**
+ * @test Removing a vertex from the middle keeps the remaining coordinates and ID order intact.
+ */
+TEST_F(NDShapeTest, RemoveVertexKeepsOtherCoordinates) {
+    std::size_t v0 = shape3D->addVertex({0,1,2});
+    std::size_t v1 = shape3D->addVertex({3,4,5});
+    std::size_t v2 = shape3D->addVertex({6,7,8});
+
+    shape3D->removeVertex(v1);
+
+    EXPECT_EQ(shape3D->getVertex(v0), (std::vector<double>{0,1,2}));
+    EXPECT_EQ(shape3D->getVertex(v2), (std::vector<double>{6,7,8}));
+    EXPECT_THROW(shape3D->getVertex(v1), std::out_of_range);
+
+    // IDs keep growing and are reported in ascending order
+    std::size_t v3 = shape3D->addVertex({9,9,9});
+    EXPECT_EQ(v3, 3U);
+    auto all = shape3D->getAllVertices();
+    ASSERT_EQ(all.size(), 3U);
+    EXPECT_EQ(all[0].first, v0);
+    EXPECT_EQ(all[1].first, v2);
+    EXPECT_EQ(all[2].first, v3);
+}
+
+/**
+ * @test Cloning to a higher dimension zero-fills the new components.
+ */
+TEST_F(NDShapeTest, CloneToHigherDimensionZeroFills) {
+    std::size_t v0 = shape3D->addVertex({1,2,3});
+    std::size_t v1 = shape3D->addVertex({4,5,6});
+    shape3D->removeVertex(v0);
+
+    NDShape shape5D = shape3D->clone(5);
+    EXPECT_EQ(shape5D.getVertex(v1), (std::vector<double>{4,5,6,0,0}));
+    EXPECT_EQ(shape5D.verticesSize(), 1);
+
+    NDShape shape2D = shape3D->clone(2);
+    EXPECT_EQ(shape2D.getVertex(v1), (std::vector<double>{4,5}));
+}
+
+/**
+ * @test hasEdge is symmetric and follows edge insertion and removal.
+ */
+TEST_F(NDShapeTest, HasEdge) {
+    std::size_t v0 = shape3D->addVertex({0,0,0});
+    std::size_t v1 = shape3D->addVertex({1,1,1});
+    std::size_t v2 = shape3D->addVertex({2,2,2});
+
+    EXPECT_FALSE(shape3D->hasEdge(v0, v1));
+    shape3D->addEdge(v0, v1);
+    shape3D->addEdge(v2, v1);
+
+    EXPECT_TRUE(shape3D->hasEdge(v0, v1));
+    EXPECT_TRUE(shape3D->hasEdge(v1, v0));
+    EXPECT_TRUE(shape3D->hasEdge(v1, v2));
+    EXPECT_FALSE(shape3D->hasEdge(v0, v2));
+    EXPECT_FALSE(shape3D->hasEdge(v0, v0));
+    EXPECT_FALSE(shape3D->hasEdge(v0, 999));
+
+    shape3D->removeEdge(v1, v0);
+    EXPECT_FALSE(shape3D->hasEdge(v0, v1));
+    EXPECT_TRUE(shape3D->hasEdge(v1, v2));
+    ASSERT_EQ(shape3D->getEdges().size(), 1U);
+}
+
+/**
+ * @test Removing a vertex drops exactly its incident edges and keeps the index consistent.
+ */
+TEST_F(NDShapeTest, RemoveVertexDropsOnlyIncidentEdges) {
+    std::vector<std::size_t> v;
+    for (int i = 0; i < 5; ++i) v.push_back(shape3D->addVertex({double(i), 0, 0}));
+    // star around v[2] plus a ring edge
+    shape3D->addEdge(v[2], v[0]);
+    shape3D->addEdge(v[2], v[1]);
+    shape3D->addEdge(v[3], v[2]);
+    shape3D->addEdge(v[2], v[4]);
+    shape3D->addEdge(v[0], v[1]);
+    shape3D->addEdge(v[3], v[4]);
+
+    shape3D->removeVertex(v[2]);
+
+    const auto& edges = shape3D->getEdges();
+    ASSERT_EQ(edges.size(), 2U);
+    EXPECT_TRUE(shape3D->hasEdge(v[0], v[1]));
+    EXPECT_TRUE(shape3D->hasEdge(v[4], v[3]));
+    EXPECT_FALSE(shape3D->hasEdge(v[2], v[0]));
+
+    // the remaining edges can still be removed and re-added
+    shape3D->removeEdge(v[3], v[4]);
+    EXPECT_NO_THROW(shape3D->addEdge(v[4], v[3]));
+    EXPECT_THROW(shape3D->addEdge(v[0], v[1]), std::invalid_argument);
+}
+
+/**
+ * @test Repeated single removals leave the slots to be sorted lazily: every
+ *       read still sees ascending IDs with their own coordinates, also from
+ *       copies that share the buffers and read them concurrently.
+ */
+TEST_F(NDShapeTest, RemoveVertexRestoresOrderOnRead) {
+    for (int i = 0; i < 64; ++i) shape3D->addVertex({double(i), double(-i), 0.5});
+    const NDShape before = *shape3D;
+
+    // interleave removals with lookups and writes that use the ID index only
+    for (std::size_t id : { 3, 0, 17, 63, 40, 41, 8 }) {
+        shape3D->removeVertex(id);
+        EXPECT_EQ(shape3D->getVertex(50)[1], -50.0);
+        EXPECT_EQ(shape3D->vertexCoords(62)[0], 62.0);
+    }
+    shape3D->setVertexCoords(9, {9.0, -9.0, 1.5});
+    shape3D->addEdge(9, 62);
+    EXPECT_EQ(shape3D->verticesSize(), 57);
+
+    const NDShape a = *shape3D;
+    const NDShape b = *shape3D;
+    auto check = [](const NDShape& s, std::vector<std::size_t>& ids) {
+        ids = s.vertexIds();
+        for (auto [id, coords] : s.vertices())
+            if (coords[0] != double(id)) ids.clear();
+    };
+    std::vector<std::size_t> idsA, idsB;
+    std::thread reader([&] { check(a, idsA); });
+    check(b, idsB);
+    reader.join();
+
+    ASSERT_EQ(idsA.size(), 57U);
+    EXPECT_EQ(idsA, idsB);
+    EXPECT_TRUE(std::is_sorted(idsA.begin(), idsA.end()));
+    EXPECT_EQ(shape3D->getVertex(9)[2], 1.5);
+    EXPECT_TRUE(shape3D->hasEdge(62, 9));
+
+    // the copy taken before the removals is untouched
+    EXPECT_EQ(before.vertexIds().size(), 64U);
+    EXPECT_EQ(before.getVertex(40)[0], 40.0);
+}
+
+/**
+ * @test Packed adjacency bits mirror the edge list, indexed by ascending vertex ID.
+ */
+TEST_F(NDShapeTest, GetAdjacencyBits) {
+    std::vector<std::size_t> v;
+    for (int i = 0; i < 4; ++i) v.push_back(shape3D->addVertex({0,0,0}));
+    shape3D->removeVertex(v[1]);           // remaining IDs: 0, 2, 3 -> rows 0, 1, 2
+    shape3D->addEdge(v[3], v[0]);
+    shape3D->addEdge(v[2], v[3]);
+
+    AdjacencyBitMatrix bits = shape3D->getAdjacencyBits();
+    ASSERT_EQ(bits.size(), 3U);
+    EXPECT_EQ(bits.count(), 2U);
+    EXPECT_TRUE(bits.test(0, 2));
+    EXPECT_TRUE(bits.test(2, 0));
+    EXPECT_TRUE(bits.test(1, 2));
+    EXPECT_FALSE(bits.test(0, 1));
+    EXPECT_FALSE(bits.test(1, 1));
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    bits.forEachSetPair([&](std::size_t i, std::size_t j) { pairs.emplace_back(i, j); });
+    ASSERT_EQ(pairs.size(), 2U);
+    EXPECT_EQ(pairs[0], std::make_pair(std::size_t(0), std::size_t(2)));
+    EXPECT_EQ(pairs[1], std::make_pair(std::size_t(1), std::size_t(2)));
+}
+
+/**
+ * @test applyAdjacencyBits adds and removes only the differing edges.
+ */
+TEST_F(NDShapeTest, ApplyAdjacencyBits) {
+    const std::size_t n = 70;              // spans more than one 64-bit word
+    for (std::size_t i = 0; i < n; ++i) shape3D->addVertex({0,0,0});
+    for (std::size_t i = 0; i + 1 < n; ++i) shape3D->addEdge(i, i + 1);
+
+    AdjacencyBitMatrix target(n);
+    for (std::size_t i = 0; i + 2 < n; i += 2) target.set(i, i + 1);   // keep every other path edge
+    target.set(0, n - 1);                                              // close a long chord
+
+    shape3D->applyAdjacencyBits(target);
+
+    EXPECT_EQ(shape3D->getAdjacencyBits(), target);
+    EXPECT_EQ(shape3D->edgesSize(), static_cast<int>(target.count()));
+    EXPECT_TRUE(shape3D->hasEdge(n - 1, 0));
+    EXPECT_FALSE(shape3D->hasEdge(1, 2));
+
+    EXPECT_THROW(shape3D->applyAdjacencyBits(AdjacencyBitMatrix(n + 1)), std::invalid_argument);
+}
+
+/**
+ * @test vertices() iterates (ID, coordinate view) pairs without copying.
+ */
+TEST_F(NDShapeTest, VerticesView) {
+    std::size_t v0 = shape3D->addVertex({1,2,3});
+    std::size_t v1 = shape3D->addVertex({4,5,6});
+    std::size_t v2 = shape3D->addVertex({7,8,9});
+    shape3D->removeVertex(v1);
+
+    std::vector<std::size_t> ids;
+    for (auto [id, coords] : shape3D->vertices()) {
+        ids.push_back(id);
+        ASSERT_EQ(coords.size(), 3U);
+        EXPECT_EQ(coords.data(), shape3D->vertexCoords(id).data());
+        EXPECT_EQ(coords.toVector(), shape3D->getVertex(id));
+    }
+    EXPECT_EQ(ids, (std::vector<std::size_t>{v0, v2}));
+    EXPECT_EQ(shape3D->vertexIds(), ids);
+    EXPECT_EQ(shape3D->vertices().size(), 2U);
+
+    EXPECT_DOUBLE_EQ(shape3D->vertexCoords(v2)[1], 8.0);
+    EXPECT_THROW(shape3D->vertexCoords(v1), std::out_of_range);
+}
+
+/**
+ * @test removeVertices drops the given vertices and their edges in one call.
+ */
+TEST_F(NDShapeTest, RemoveVerticesBatch) {
+    std::vector<std::size_t> v;
+    for (int i = 0; i < 6; ++i) v.push_back(shape3D->addVertex({double(i), 0, 0}));
+    for (int i = 0; i < 6; ++i) shape3D->addEdge(v[i], v[(i + 1) % 6]);   // hexagon
+    shape3D->addEdge(v[0], v[3]);
+
+    shape3D->removeVertices({v[1], v[4], v[1]});
+
+    EXPECT_EQ(shape3D->vertexIds(), (std::vector<std::size_t>{v[0], v[2], v[3], v[5]}));
+    EXPECT_EQ(shape3D->getVertex(v[5]), (std::vector<double>{5, 0, 0}));
+    EXPECT_EQ(shape3D->edgesSize(), 3);
+    EXPECT_TRUE(shape3D->hasEdge(v[2], v[3]));
+    EXPECT_TRUE(shape3D->hasEdge(v[5], v[0]));
+    EXPECT_TRUE(shape3D->hasEdge(v[0], v[3]));
+
+    // indices stay consistent for later single edits
+    shape3D->removeVertex(v[3]);
+    EXPECT_EQ(shape3D->edgesSize(), 1);
+    EXPECT_TRUE(shape3D->hasEdge(v[0], v[5]));
+
+    // unknown IDs abort the whole batch
+    EXPECT_THROW(shape3D->removeVertices({v[0], v[1]}), std::out_of_range);
+    EXPECT_EQ(shape3D->verticesSize(), 3);
+}
+
+/**
+ * @test removeEdges drops exactly the listed edges.
+ */
+TEST_F(NDShapeTest, RemoveEdgesBatch) {
+    std::vector<std::size_t> v;
+    for (int i = 0; i < 4; ++i) v.push_back(shape3D->addVertex({0, 0, 0}));
+    shape3D->addEdge(v[0], v[1]);
+    shape3D->addEdge(v[1], v[2]);
+    shape3D->addEdge(v[2], v[3]);
+    shape3D->addEdge(v[3], v[0]);
+
+    shape3D->removeEdges({{v[1], v[0]}, {v[2], v[3]}});
+
+    EXPECT_EQ(shape3D->edgesSize(), 2);
+    EXPECT_TRUE(shape3D->hasEdge(v[1], v[2]));
+    EXPECT_TRUE(shape3D->hasEdge(v[0], v[3]));
+    EXPECT_FALSE(shape3D->hasEdge(v[0], v[1]));
+
+    shape3D->removeVertex(v[2]);
+    EXPECT_EQ(shape3D->edgesSize(), 1);
+
+    EXPECT_THROW(shape3D->removeEdges({{v[0], v[3]}, {v[0], v[1]}}), std::out_of_range);
+    EXPECT_EQ(shape3D->edgesSize(), 1);
+}
+
+/**
+ * @test Copies share buffers until one side is modified.
+ */
+TEST_F(NDShapeTest, CopyOnWrite) {
+    std::size_t a = shape3D->addVertex({1, 2, 3});
+    std::size_t b = shape3D->addVertex({4, 5, 6});
+    shape3D->addEdge(a, b);
+
+    NDShape copy = *shape3D;
+    EXPECT_EQ(std::as_const(copy).coordinateData(), std::as_const(*shape3D).coordinateData());
+    EXPECT_EQ(&copy.getEdges(), &shape3D->getEdges());
+
+    copy.setVertexCoords(a, {7, 8, 9});
+    EXPECT_EQ(shape3D->getVertex(a), (std::vector<double>{1, 2, 3}));
+    EXPECT_EQ(copy.getVertex(a), (std::vector<double>{7, 8, 9}));
+    EXPECT_EQ(&copy.getEdges(), &shape3D->getEdges());   // topology still shared
+
+    copy.removeEdge(a, b);
+    EXPECT_TRUE(shape3D->hasEdge(a, b));
+    EXPECT_FALSE(copy.hasEdge(a, b));
+
+    // a failed mutation does not unshare
+    NDShape other = *shape3D;
+    EXPECT_THROW(other.removeVertex(42), std::out_of_range);
+    EXPECT_EQ(&other.getEdges(), &shape3D->getEdges());
+
+    // in-place rewrites through the raw buffer stay private to the copy
+    other.coordinateData()[0] = -1;
+    EXPECT_EQ(shape3D->getVertex(a)[0], 1);
+    EXPECT_EQ(other.getVertex(a)[0], -1);
+
+    // a moved-from shape reads as empty
+    NDShape moved = std::move(other);
+    EXPECT_EQ(moved.verticesSize(), 2);
+}
+
+/**
+ * @test compact() renumbers densely in BFS order and returns the remap.
+ */
+TEST_F(NDShapeTest, CompactRenumbersBreadthFirst) {
+    std::vector<std::size_t> v;
+    for (int i = 0; i < 7; ++i) v.push_back(shape3D->addVertex({double(i), 0, 0}));
+    shape3D->removeVertex(v[1]);
+    shape3D->addEdge(v[0], v[6]);
+    shape3D->addEdge(v[6], v[3]);
+    shape3D->addEdge(v[0], v[4]);
+    shape3D->addEdge(v[2], v[5]);
+
+    NDShape before = *shape3D;
+    std::vector<std::size_t> remap = shape3D->compact();
+
+    ASSERT_EQ(remap.size(), 7U);
+    EXPECT_EQ(remap[v[1]], NDShape::npos);
+    // component {0,4,6,3} first (neighbours ascending), then {2,5}
+    EXPECT_EQ(remap[v[0]], 0U);
+    EXPECT_EQ(remap[v[4]], 1U);
+    EXPECT_EQ(remap[v[6]], 2U);
+    EXPECT_EQ(remap[v[3]], 3U);
+    EXPECT_EQ(remap[v[2]], 4U);
+    EXPECT_EQ(remap[v[5]], 5U);
+
+    EXPECT_EQ(shape3D->vertexIds(), (std::vector<std::size_t>{0, 1, 2, 3, 4, 5}));
+    for (std::size_t oldId : before.vertexIds())
+        EXPECT_EQ(shape3D->getVertex(remap[oldId]), before.getVertex(oldId));
+    EXPECT_EQ(shape3D->edgesSize(), before.edgesSize());
+    for (const auto& [a, b] : before.getEdges())
+        EXPECT_TRUE(shape3D->hasEdge(remap[a], remap[b]));
+
+    // the copy taken before is unaffected, and new IDs continue densely
+    EXPECT_EQ(before.getVertex(v[6]), (std::vector<double>{6, 0, 0}));
+    EXPECT_EQ(shape3D->addVertex({0, 0, 0}), 6U);
+    shape3D->removeVertex(remap[v[6]]);
+    EXPECT_EQ(shape3D->edgesSize(), 2);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../model/NDShapeBuilder.h"
+#include <stdexcept>
+
+/**
+ * @test Bulk vertices and edges end up in a fully indexed shape.
+ */
+TEST(NDShapeBuilderTest, BuildFromFlatArrays) {
+    NDShapeBuilder builder(2, 4, 4);
+    const std::vector<double> flat = {0,0,  1,0,  1,1,  0,1};
+    std::size_t first = builder.addVertices(flat.data(), 4);
+    EXPECT_EQ(first, 0U);
+
+    const std::vector<std::pair<std::size_t, std::size_t>> edges = {{0,1}, {1,2}, {2,3}, {3,0}};
+    builder.addEdges(edges.data(), edges.size());
+
+    NDShape square = builder.finish();
+    EXPECT_EQ(square.getDimension(), 2U);
+    EXPECT_EQ(square.verticesSize(), 4);
+    EXPECT_EQ(square.edgesSize(), 4);
+    EXPECT_EQ(square.getVertex(2), (std::vector<double>{1,1}));
+    EXPECT_TRUE(square.hasEdge(0, 3));
+
+    // the finished shape behaves like one built incrementally
+    EXPECT_EQ(square.addVertex({5,5}), 4U);
+    EXPECT_THROW(square.addEdge(1, 0), std::invalid_argument);
+    square.removeVertex(1);
+    EXPECT_EQ(square.edgesSize(), 2);
+}
+
+/**
+ * @test Vertices with explicit IDs may arrive out of order and leave gaps.
+ */
+TEST(NDShapeBuilderTest, ExplicitIdsAreSortedAndKept) {
+    NDShapeBuilder builder(1);
+    builder.addVertexWithId(7, {7.0});
+    builder.addVertexWithId(2, {2.0});
+    builder.addVertexWithId(4, {4.0});
+    builder.addEdge(7, 2);
+
+    NDShape shape = builder.finish();
+    EXPECT_EQ(shape.vertexIds(), (std::vector<std::size_t>{2, 4, 7}));
+    EXPECT_EQ(shape.getVertex(7), (std::vector<double>{7.0}));
+    EXPECT_TRUE(shape.hasEdge(2, 7));
+    EXPECT_EQ(shape.addVertex({8.0}), 8U);
+}
+
+/**
+ * @test finish() reports invalid input with the same exception types as NDShape.
+ */
+TEST(NDShapeBuilderTest, FinishValidates) {
+    {
+        NDShapeBuilder builder(1);
+        builder.addVertexWithId(1, {0.0});
+        builder.addVertexWithId(1, {1.0});
+        EXPECT_THROW(builder.finish(), std::invalid_argument);
+    }
+    {
+        NDShapeBuilder builder(1);
+        builder.addVertex({0.0});
+        builder.addEdge(0, 5);
+        EXPECT_THROW(builder.finish(), std::out_of_range);
+    }
+    {
+        NDShapeBuilder builder(1);
+        builder.addVertexWithId(0, {0.0});
+        builder.addVertexWithId(2, {0.0});
+        builder.addEdge(0, 1);                 // 1 is a hole below the counter
+        EXPECT_THROW(builder.finish(), std::out_of_range);
+    }
+    {
+        NDShapeBuilder builder(1);
+        builder.addVertex({0.0});
+        builder.addEdge(0, 0);
+        EXPECT_THROW(builder.finish(), std::invalid_argument);
+    }
+    {
+        NDShapeBuilder builder(1);
+        builder.addVertex({0.0});
+        builder.addVertex({1.0});
+        builder.addEdge(0, 1);
+        builder.addEdge(1, 0);
+        EXPECT_THROW(builder.finish(), std::invalid_argument);
+    }
+    EXPECT_THROW(NDShapeBuilder(0), std::invalid_argument);
+    EXPECT_THROW(NDShapeBuilder(2).addVertex({1.0}), std::invalid_argument);
+}
+
+/**
+ * @test Building on top of an existing shape keeps its data and continues its IDs.
+ */
+TEST(NDShapeBuilderTest, ContinueExistingShape) {
+    NDShape base(2);
+    base.addVertex({0,0});
+    base.addVertex({1,1});
+    base.addEdge(0, 1);
+    base.removeVertex(0);
+    base.addVertex({2,2});                     // ID 2
+
+    NDShapeBuilder builder(std::move(base), 2, 1);
+    std::size_t id = builder.addVertex({3,3});
+    EXPECT_EQ(id, 3U);
+    builder.addEdge(1, id);
+    builder.addEdge(2, 1);
+
+    NDShape shape = builder.finish();
+    EXPECT_EQ(shape.vertexIds(), (std::vector<std::size_t>{1, 2, 3}));
+    EXPECT_EQ(shape.edgesSize(), 2);
+    EXPECT_TRUE(shape.hasEdge(3, 1));
+    EXPECT_TRUE(shape.hasEdge(1, 2));
+    EXPECT_FALSE(shape.hasEdge(0, 1));
+}
@@ -0,0 +1,409 @@
+#include <gtest/gtest.h>
+#include "../model/geometryKernels.h"
+#include "../model/projection.h"
+#include "../model/rotator.h"
+#include "../model/simdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+std::vector<double> sampleRows(std::size_t count, std::size_t dim) {
+    std::vector<double> rows(count * dim);
+    for (std::size_t k = 0; k < rows.size(); ++k)
+        rows[k] = std::sin(0.37 * double(k)) * 0.5;   // |x| < 1 keeps every projection defined
+    return rows;
+}
+
+void expectRowsNear(const std::vector<double>& a, const std::vector<double>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t k = 0; k < a.size(); ++k)
+        EXPECT_NEAR(a[k], b[k], 1e-12) << "at " << k;
+}
+} // namespace
+
+/**
+ * @test Every specialised table matches the generic kernels.
+ */
+TEST(GeometryKernelsTest, SpecialisedMatchGeneric) {
+    const KernelTable& generic = kernelsFor(0);
+    EXPECT_EQ(generic.dimension, 0U);
+    EXPECT_EQ(kernelsFor(kMaxKernelDimension + 1).dimension, 0U);
+
+    const std::size_t count = 7;
+    for (std::size_t dim = kMinKernelDimension; dim <= kMaxKernelDimension; ++dim) {
+        const KernelTable& k = kernelsFor(dim);
+        ASSERT_EQ(k.dimension, dim);
+
+        std::vector<double> a = sampleRows(count, dim), b = a;
+        k.rotatePlane(a.data(), count, dim, 0, dim - 1, 0.6, 0.8);
+        generic.rotatePlane(b.data(), count, dim, 0, dim - 1, 0.6, 0.8);
+        expectRowsNear(a, b);
+
+        std::vector<double> scale(dim, 2.0), offset(dim, -1.0);
+        k.scaleOffset(a.data(), count, dim, scale.data(), offset.data());
+        generic.scaleOffset(b.data(), count, dim, scale.data(), offset.data());
+        expectRowsNear(a, b);
+
+        const std::vector<double> in = sampleRows(count, dim);
+        std::vector<double> outA(count * (dim - 1)), outB(outA.size());
+        EXPECT_TRUE(k.projectPerspective(in.data(), outA.data(), count, dim, 3.0));
+        EXPECT_TRUE(generic.projectPerspective(in.data(), outB.data(), count, dim, 3.0));
+        expectRowsNear(outA, outB);
+
+        EXPECT_TRUE(k.projectStereographic(in.data(), outA.data(), count, dim));
+        EXPECT_TRUE(generic.projectStereographic(in.data(), outB.data(), count, dim));
+        expectRowsNear(outA, outB);
+
+        k.projectOrthographic(in.data(), outA.data(), count, dim);
+        generic.projectOrthographic(in.data(), outB.data(), count, dim);
+        expectRowsNear(outA, outB);
+    }
+}
+
+/**
+ * @test Shape projection, projectPoints() and projectPoint() follow the formula and keep errors.
+ */
+TEST(GeometryKernelsTest, ProjectShapeMatchesProjectPoint) {
+    NDShape shape(5);
+    for (int i = 0; i < 4; ++i)
+        shape.addVertex({0.1 * i, 0.2, -0.3, 0.4 * i, 0.25 * i});
+    shape.addEdge(0, 3);
+
+    PerspectiveProjection persp(2.0);
+    NDShape projected = persp.projectShape(shape);
+    ASSERT_EQ(projected.getDimension(), 4U);
+    EXPECT_TRUE(projected.hasEdge(0, 3));
+    for (std::size_t id : shape.vertexIds()) {
+        std::vector<double> p = shape.getVertex(id);
+        std::vector<double> expected(4);
+        for (std::size_t i = 0; i < 4; ++i)
+            expected[i] = 2.0 * p[i] / (p[4] + 2.0);
+        expectRowsNear(projected.getVertex(id), expected);
+        expectRowsNear(persp.projectPoint(p), expected);
+    }
+
+    std::vector<double> batch(4 * 4);
+    persp.projectPoints(shape.coordinateData(), 4, 5, batch.data());
+    expectRowsNear(batch, std::vector<double>(projected.coordinateData(),
+                                              projected.coordinateData() + batch.size()));
+    EXPECT_THROW(persp.projectPoint({1.0}), std::invalid_argument);
+
+    NDShape pole(3);
+    pole.addVertex({0.0, 0.0, 1.0});
+    EXPECT_THROW(StereographicProjection().projectShape(pole), std::runtime_error);
+}
+
+/**
+ * @test Rotation through the kernel table leaves the source shape untouched.
+ */
+TEST(GeometryKernelsTest, RotatorUsesKernels) {
+    NDShape shape(4);
+    std::size_t id = shape.addVertex({1, 0, 0, 0});
+
+    NDShape rotated = Rotator(0, 3, std::acos(-1.0) / 2).applyRotation(shape);
+    expectRowsNear(rotated.getVertex(id), {0, 0, 0, 1});
+    EXPECT_EQ(shape.getVertex(id), (std::vector<double>{1, 0, 0, 0}));
+}
+
+/**
+ * @test The vector kernels of every supported tier match the scalar ones bit for bit,
+ *       including partial tail blocks.
+ */
+TEST(GeometryKernelsTest, SimdMatchesScalar) {
+    const double rotation[4 * 4] = { 0.6, -0.8, 0.0, 0.0,
+                                     0.8,  0.6, 0.0, 0.0,
+                                     0.0,  0.0, 0.0, -1.0,
+                                     0.0,  0.0, 1.0, 0.0 };
+    for (int l = 1; l <= static_cast<int>(detectSimdLevel()); ++l) {
+        const SimdLevel level = static_cast<SimdLevel>(l);
+        SCOPED_TRACE(simdLevelName(level));
+        for (std::size_t dim = kMinKernelDimension; dim <= kMaxKernelDimension; ++dim) {
+            const KernelTable& simd   = kernelsFor(dim, level);
+            const KernelTable& scalar = kernelsFor(dim, SimdLevel::Scalar);
+            for (std::size_t count : { 1U, 5U, 7U, 8U }) {
+                std::vector<double> a = sampleRows(count, dim), b = a;
+                simd.rotatePlane(a.data(), count, dim, 0, dim - 1, 0.6, 0.8);
+                scalar.rotatePlane(b.data(), count, dim, 0, dim - 1, 0.6, 0.8);
+                EXPECT_EQ(a, b);
+
+                std::vector<double> outA(count * (dim - 1)), outB(outA.size());
+                EXPECT_TRUE(simd.projectPerspective(a.data(), outA.data(), count, dim, 3.0));
+                scalar.projectPerspective(a.data(), outB.data(), count, dim, 3.0);
+                EXPECT_EQ(outA, outB);
+
+                EXPECT_TRUE(simd.projectStereographic(a.data(), outA.data(), count, dim));
+                scalar.projectStereographic(a.data(), outB.data(), count, dim);
+                EXPECT_EQ(outA, outB);
+
+                const std::vector<double> scale(3, 1.5), offset(3, -0.25);
+                const std::size_t target = dim < 3 ? dim : 3;
+                std::vector<double> fusedA(count * target), fusedB(fusedA.size());
+                std::vector<unsigned char> validA(count), validB(count);
+                const double* m = dim == 4 ? rotation : nullptr;
+                for (const ProjectionParams& proj : { ProjectionParams{ PerspectiveParams{ 3.0 } },
+                                                      ProjectionParams{ OrthographicParams{} },
+                                                      ProjectionParams{ StereographicParams{} } }) {
+                    const HomogeneousTransform t = composeHomogeneous(
+                        dim, target, m, proj, scale.data(), offset.data());
+                    EXPECT_EQ(simd.convertHomogeneous(a.data(), fusedA.data(), count, dim, target,
+                                                      t.matrix.data(), t.divide, validA.data()), 0U);
+                    scalar.convertHomogeneous(a.data(), fusedB.data(), count, dim, target,
+                                              t.matrix.data(), t.divide, validB.data());
+                    EXPECT_EQ(fusedA, fusedB);
+                    EXPECT_EQ(validA, validB);
+
+                    const std::vector<float> m32(t.matrix.begin(), t.matrix.end());
+                    std::vector<float> singleA(fusedA.size()), singleB(fusedA.size());
+                    EXPECT_EQ(simd.convertHomogeneousSingle(a.data(), singleA.data(), count, dim,
+                                                            target, m32.data(), t.divide,
+                                                            validA.data(), target), 0U);
+                    scalar.convertHomogeneousSingle(a.data(), singleB.data(), count, dim, target,
+                                                    m32.data(), t.divide, validB.data(), target);
+                    EXPECT_EQ(singleA, singleB);
+                    EXPECT_EQ(validA, validB);
+
+                    // strided rows land in place and leave the gaps alone
+                    const std::size_t stride = target + 3;
+                    std::vector<float> strided(count * stride, -7.0f);
+                    simd.convertHomogeneousSingle(a.data(), strided.data(), count, dim, target,
+                                                  m32.data(), t.divide, validA.data(), stride);
+                    for (std::size_t v = 0; v < count; ++v)
+                        for (std::size_t i = 0; i < stride; ++i)
+                            EXPECT_EQ(strided[v * stride + i],
+                                      i < target ? singleB[v * target + i] : -7.0f);
+                    for (std::size_t k = 0; k < singleA.size(); ++k)
+                        EXPECT_NEAR(singleA[k], fusedA[k], 1e-5 * std::max(1.0, std::fabs(fusedA[k])));
+                }
+            }
+        }
+
+        // a pole in the last, partial block is still reported
+        std::vector<double> rows = sampleRows(5, 3);
+        rows[4 * 3 + 2] = 1.0;
+        std::vector<double> out(5 * 2);
+        EXPECT_FALSE(kernelsFor(3, level).projectStereographic(rows.data(), out.data(), 5, 3));
+
+        std::vector<unsigned char> valid(5);
+        const HomogeneousTransform stereo = composeHomogeneous(
+            3, 2, nullptr, StereographicParams{}, nullptr, nullptr);
+        EXPECT_EQ(kernelsFor(3, level).convertHomogeneous(rows.data(), out.data(), 5, 3, 2,
+                                                          stereo.matrix.data(), stereo.divide,
+                                                          valid.data()), 1U);
+        EXPECT_EQ(valid, (std::vector<unsigned char>{ 1, 1, 1, 1, 0 }));
+    }
+}
+
+/**
+ * @test Single precision flags denominators below its own threshold, which
+ *       the double kernels still accept, on every tier.
+ */
+TEST(GeometryKernelsTest, SingleUsesFloatThreshold) {
+    std::vector<double> rows = sampleRows(5, 3);
+    rows[2 * 3 + 2] = 0.9999995;   // w = 1 - x is about 5e-7 in float and double
+    const HomogeneousTransform stereo = composeHomogeneous(
+        3, 2, nullptr, StereographicParams{}, nullptr, nullptr);
+    const std::vector<float> m32(stereo.matrix.begin(), stereo.matrix.end());
+    const std::vector<unsigned char> expected{ 1, 1, 0, 1, 1 };
+
+    for (int l = 0; l <= static_cast<int>(detectSimdLevel()); ++l) {
+        const SimdLevel level = static_cast<SimdLevel>(l);
+        SCOPED_TRACE(simdLevelName(level));
+        const KernelTable& k = kernelsFor(3, level);
+        std::vector<unsigned char> valid(5);
+
+        std::vector<double> out(5 * 2);
+        EXPECT_EQ(k.convertHomogeneous(rows.data(), out.data(), 5, 3, 2, stereo.matrix.data(),
+                                       stereo.divide, valid.data()), 0U);
+
+        std::vector<float> outSingle(5 * 2);
+        EXPECT_EQ(k.convertHomogeneousSingle(rows.data(), outSingle.data(), 5, 3, 2, m32.data(),
+                                             stereo.divide, valid.data(), 2), 1U);
+        EXPECT_EQ(valid, expected);
+    }
+
+    std::vector<double> columns(5 * 3);
+    for (std::size_t v = 0; v < 5; ++v)
+        for (std::size_t j = 0; j < 3; ++j)
+            columns[j * 5 + v] = rows[v * 3 + j];
+    const double* columnPtrs[3] = { &columns[0], &columns[5], &columns[10] };
+    std::vector<float> outSingle(5 * 2);
+    std::vector<unsigned char> valid(5);
+    EXPECT_EQ(convertDiagonalSingle(columnPtrs, outSingle.data(), 5, 3, 2, m32.data(), nullptr,
+                                    stereo.divide, valid.data(), 2), 1U);
+    EXPECT_EQ(valid, expected);
+}
+
+/**
+ * @test The closed-form cascade matches projecting one dimension at a time
+ *       and keeps the source topology.
+ */
+TEST(GeometryKernelsTest, CascadeMatchesStepwiseProjection) {
+    NDShape shape(12);
+    std::vector<double> rows = sampleRows(9, 12);
+    for (std::size_t v = 0; v < 9; ++v)
+        shape.addVertex(std::vector<double>(rows.begin() + v * 12, rows.begin() + (v + 1) * 12));
+    shape.addEdge(0, 8);
+    shape.addEdge(2, 5);
+
+    const std::vector<std::shared_ptr<Projection>> projections = {
+        std::make_shared<PerspectiveProjection>(3.0),
+        std::make_shared<OrthographicProjection>(),
+        std::make_shared<StereographicProjection>(),
+    };
+    for (const auto& projection : projections) {
+        NDShape stepwise = shape;
+        while (stepwise.getDimension() > 3)
+            stepwise = projection->projectShape(stepwise);
+
+        NDShape cascaded = projection->projectShapeToDimension(shape, 3);
+        ASSERT_EQ(cascaded.getDimension(), 3U);
+        EXPECT_EQ(&cascaded.getEdges(), &shape.getEdges());
+        for (std::size_t id : shape.vertexIds())
+            expectRowsNear(cascaded.getVertex(id), stepwise.getVertex(id));
+    }
+}
+
+/**
+ * @test Built-in projections describe themselves as closed alternatives
+ *       that round-trip through makeProjection().
+ */
+TEST(GeometryKernelsTest, ProjectionParamsRoundTrip) {
+    const std::vector<ProjectionParams> all = { PerspectiveParams{ 2.5 }, OrthographicParams{},
+                                                StereographicParams{} };
+    for (const ProjectionParams& params : all) {
+        auto projection = makeProjection(params);
+        ASSERT_TRUE(projection);
+        EXPECT_EQ(projection->kernelParams(), params);
+        EXPECT_EQ(projection->clone()->kernelParams(), params);
+    }
+    EXPECT_FALSE(makeProjection(std::monostate{}));
+    EXPECT_NE(ProjectionParams{ PerspectiveParams{ 2.5 } }, ProjectionParams{ PerspectiveParams{ 3.0 } });
+    EXPECT_STREQ(projectionName(StereographicParams{}), "StereographicProjection");
+    EXPECT_STREQ(projectionName(std::monostate{}), "Projection");
+}
+
+/**
+ * @test The dimension-major diagonal conversion matches the homogeneous
+ *       kernel on an unrotated matrix, with and without a divide, and
+ *       flags the same rows; rotateColumns() matches rotatePlane().
+ */
+TEST(GeometryKernelsTest, DiagonalMatchesHomogeneous) {
+    const std::size_t dim = 6, count = 700;
+    std::vector<double> rows = sampleRows(count, dim);
+    rows[5 * dim + 3] = -3.0;   // vertex 5 sits on the perspective pole
+    rows[5 * dim + 4] = rows[5 * dim + 5] = 0.0;
+
+    std::vector<std::vector<double>> columns(dim, std::vector<double>(count));
+    std::vector<const double*> columnPtrs;
+    for (std::size_t i = 0; i < dim; ++i) {
+        for (std::size_t v = 0; v < count; ++v)
+            columns[i][v] = rows[v * dim + i];
+        columnPtrs.push_back(columns[i].data());
+    }
+
+    const double scale[]  = { 2.0, -1.0, 0.5, 3.0 };
+    const double offset[] = { 0.25, 1.0, -2.0, 0.5 };
+    const std::vector<ProjectionParams> projections = { PerspectiveParams{ 3.0 },
+                                                        OrthographicParams{} };
+    for (std::size_t targetDim : { std::size_t(2), std::size_t(3), std::size_t(4) }) {
+        for (const ProjectionParams& proj : projections) {
+            HomogeneousTransform t = composeHomogeneous(dim, targetDim, nullptr, proj, scale, offset);
+            std::vector<double> expected(count * targetDim), actual(count * targetDim);
+            std::vector<unsigned char> expectedValid(count), actualValid(count);
+            const std::size_t invalid = kernelsFor(dim).convertHomogeneous(
+                rows.data(), expected.data(), count, dim, targetDim, t.matrix.data(), t.divide,
+                expectedValid.data());
+            EXPECT_EQ(convertDiagonal(columnPtrs.data(), actual.data(), count, dim, targetDim,
+                                      t.matrix.data(), offset, t.divide, actualValid.data()),
+                      invalid);
+            EXPECT_EQ(actualValid, expectedValid);
+            for (std::size_t v = 0; v < count; ++v)
+                for (std::size_t i = 0; v != 5 && i < targetDim; ++i)
+                    EXPECT_NEAR(actual[v * targetDim + i], expected[v * targetDim + i], 1e-12);
+        }
+    }
+
+    std::vector<double> x(count), y(count);
+    rotateColumns(columns[1].data(), columns[4].data(), x.data(), y.data(), count,
+                  std::cos(0.3), std::sin(0.3));
+    kernelsFor(dim).rotatePlane(rows.data(), count, dim, 1, 4, std::cos(0.3), std::sin(0.3));
+    for (std::size_t v = 0; v < count; ++v) {
+        EXPECT_NEAR(x[v], rows[v * dim + 1], 1e-15);
+        EXPECT_NEAR(y[v], rows[v * dim + 4], 1e-15);
+    }
+}
+
+/**
+ * @test The vector column kernels give the scalar results bit for bit,
+ *       including partial tail blocks, strided output and pole flags.
+ */
+TEST(GeometryKernelsTest, SimdColumnKernelsMatchScalar) {
+    const std::vector<double> scale(3, 1.5), offset(3, -0.25);
+    const std::vector<float> offset32(offset.begin(), offset.end());
+    for (int l = 1; l <= static_cast<int>(detectSimdLevel()); ++l) {
+        const SimdLevel level = static_cast<SimdLevel>(l);
+        SCOPED_TRACE(simdLevelName(level));
+        for (std::size_t dim : { 2U, 3U, 4U, 7U, 12U }) {
+            const KernelTable& simd   = kernelsFor(dim, level);
+            const KernelTable& scalar = kernelsFor(dim, SimdLevel::Scalar);
+            const std::size_t target  = dim < 3 ? dim : 3;
+            for (std::size_t count : { 1U, 5U, 8U, 9U, 17U }) {
+                const std::vector<double> rows = sampleRows(count, dim);
+                std::vector<double> columns(count * dim);
+                std::vector<const double*> columnPtrs(dim);
+                for (std::size_t i = 0; i < dim; ++i) {
+                    for (std::size_t v = 0; v < count; ++v)
+                        columns[i * count + v] = rows[v * dim + i];
+                    columnPtrs[i] = &columns[i * count];
+                }
+                if (dim > 3)
+                    columns[(dim - 1) * count + count - 1] = 1.0;   // pole in the tail block
+
+                std::vector<double> xA(count), yA(count), xB(count), yB(count);
+                simd.rotateColumns(columnPtrs[0], columnPtrs[dim - 1], xA.data(), yA.data(),
+                                   count, 0.6, 0.8);
+                scalar.rotateColumns(columnPtrs[0], columnPtrs[dim - 1], xB.data(), yB.data(),
+                                     count, 0.6, 0.8);
+                EXPECT_EQ(xA, xB);
+                EXPECT_EQ(yA, yB);
+
+                for (const ProjectionParams& proj : { ProjectionParams{ PerspectiveParams{ 3.0 } },
+                                                      ProjectionParams{ OrthographicParams{} },
+                                                      ProjectionParams{ StereographicParams{} } }) {
+                    const HomogeneousTransform t = composeHomogeneous(
+                        dim, target, nullptr, proj, scale.data(), offset.data());
+                    std::vector<double> outA(count * target), outB(outA.size());
+                    std::vector<unsigned char> validA(count), validB(count);
+                    EXPECT_EQ(simd.convertDiagonal(columnPtrs.data(), outA.data(), count, dim,
+                                                   target, t.matrix.data(), offset.data(),
+                                                   t.divide, validA.data()),
+                              scalar.convertDiagonal(columnPtrs.data(), outB.data(), count, dim,
+                                                     target, t.matrix.data(), offset.data(),
+                                                     t.divide, validB.data()));
+                    EXPECT_EQ(validA, validB);
+                    for (std::size_t k = 0; k < outA.size(); ++k)
+                        if (validB[k / target]) {   // a pole row holds inf or nan
+                            EXPECT_EQ(outA[k], outB[k]);
+                        }
+
+                    const std::vector<float> m32(t.matrix.begin(), t.matrix.end());
+                    const std::size_t stride = target + 3;
+                    std::vector<float> singleA(count * stride, -7.0f), singleB(singleA);
+                    EXPECT_EQ(simd.convertDiagonalSingle(columnPtrs.data(), singleA.data(), count,
+                                                         dim, target, m32.data(), offset32.data(),
+                                                         t.divide, validA.data(), stride),
+                              scalar.convertDiagonalSingle(columnPtrs.data(), singleB.data(),
+                                                           count, dim, target, m32.data(),
+                                                           offset32.data(), t.divide,
+                                                           validB.data(), stride));
+                    EXPECT_EQ(validA, validB);
+                    for (std::size_t k = 0; k < singleA.size(); ++k)
+                        if (validB[k / stride] || k % stride >= target) {
+                            EXPECT_EQ(singleA[k], singleB[k]);
+                        }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "../model/isoclinicRotation.h"
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @test Every single plane, in either axis order, matches its Givens matrix.
+ */
+TEST(IsoclinicRotationTest, PlaneRotationsMatchGivens) {
+    for (std::size_t a = 0; a < 4; ++a) {
+        for (std::size_t b = 0; b < 4; ++b) {
+            if (a == b) continue;
+            const std::vector<Rotator> chain = { Rotator(a, b, 0.7) };
+            const std::vector<double> expected = Rotator::composeChain(chain, 4);
+            const std::vector<double> actual   = IsoclinicPair::fromChain(chain).toMatrix();
+            for (std::size_t k = 0; k < 16; ++k)
+                EXPECT_NEAR(actual[k], expected[k], 1e-15) << "plane (" << a << ", " << b << ")";
+        }
+    }
+}
+
+/**
+ * @test A long random chain folds into the same rotation as the composed
+ *       Givens matrices, and apply() agrees with toMatrix().
+ */
+TEST(IsoclinicRotationTest, ChainMatchesComposedMatrix) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> axis(0, 3);
+    std::uniform_real_distribution<double> angle(-3.0, 3.0);
+
+    std::vector<Rotator> chain;
+    while (chain.size() < 50) {
+        std::size_t a = axis(rng), b = axis(rng);
+        if (a != b) chain.push_back(Rotator(a, b, angle(rng)));
+    }
+
+    const IsoclinicPair pair = IsoclinicPair::fromChain(chain);
+    const std::vector<double> expected = Rotator::composeChain(chain, 4);
+    const std::vector<double> actual   = pair.toMatrix();
+    for (std::size_t k = 0; k < 16; ++k)
+        EXPECT_NEAR(actual[k], expected[k], 1e-13);
+
+    double p[4] = { 0.3, -1.2, 0.5, 2.0 };
+    double q[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+            q[i] += actual[i * 4 + j] * p[j];
+    pair.apply(p);
+    for (std::size_t i = 0; i < 4; ++i)
+        EXPECT_NEAR(p[i], q[i], 1e-13);
+
+    EXPECT_THROW(IsoclinicPair::fromChain({ Rotator(1, 4, 0.1) }), std::invalid_argument);
+    EXPECT_THROW(IsoclinicPair::fromChain({ Rotator(2, 2, 0.1) }), std::invalid_argument);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "../model/parallelFor.h"
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @test Every item runs exactly once and the first exception reaches the caller.
+ */
+TEST(ParallelForTest, RunsEveryItemOnce) {
+    std::vector<std::atomic<int>> hits(200);
+    parallelFor(hits.size(), [&](std::size_t i) { ++hits[i]; }, 8);
+    for (const auto& h : hits)
+        EXPECT_EQ(h.load(), 1);
+
+    EXPECT_THROW(parallelFor(50, [](std::size_t i) {
+                     if (i == 17) throw std::runtime_error("item 17");
+                 }, 4),
+                 std::runtime_error);
+}
+
+/**
+ * @test Chunks with very uneven cost still cover the range exactly once.
+ */
+TEST(ParallelForTest, RangeCoversEveryIndexOnce) {
+    const std::size_t n = 10007;
+    std::vector<std::atomic<int>> hits(n);
+    std::atomic<std::size_t> chunks{0};
+    parallelForRange(0, n, 64, [&](std::size_t b, std::size_t e) {
+        ASSERT_LE(e - b, 64U);
+        ++chunks;
+        volatile double sink = 0.0;
+        const std::size_t work = b < n / 8 ? 20000 : 10;   // the first part is much slower
+        for (std::size_t k = 0; k < work; ++k) sink += std::sqrt(double(k));
+        for (std::size_t i = b; i < e; ++i) ++hits[i];
+    }, 6);
+
+    for (std::size_t i = 0; i < n; ++i)
+        ASSERT_EQ(hits[i].load(), 1) << "index " << i;
+    EXPECT_GE(chunks.load(), (n + 63) / 64);
+
+    parallelForRange(5, 5, 64, [](std::size_t, std::size_t) { FAIL(); });
+}
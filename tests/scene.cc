@@ -0,0 +1,521 @@
+#include <gtest/gtest.h>
+#include "../model/scene.h"
+#include "../model/projection.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+std::shared_ptr<NDShape> makeTesseractCorners() {
+    auto shape = std::make_shared<NDShape>(4);
+    for (int m = 0; m < 16; ++m)
+        shape->addVertex({ double(m & 1) - 0.5, double((m >> 1) & 1) - 0.5,
+                           double((m >> 2) & 1) - 0.5, double((m >> 3) & 1) - 0.5 });
+    shape->addEdge(0, 1);
+    shape->addEdge(0, 8);
+    return shape;
+}
+
+std::shared_ptr<NDShape> makeRandomShape(std::size_t dim, std::size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> coord(-0.5, 0.5);
+    auto shape = std::make_shared<NDShape>(dim);
+    for (std::size_t v = 0; v < count; ++v) {
+        std::vector<double> p(dim);
+        for (double& c : p) c = coord(rng);
+        shape->addVertex(p);
+    }
+    for (std::size_t v = 1; v < count; ++v)
+        shape->addEdge(v - 1, v);
+    return shape;
+}
+} // namespace
+
+/**
+ * @test The composed rotation matrix matches applying the rotators one by one.
+ */
+TEST(SceneTest, RotatorChainMatchesSequentialRotation) {
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.shape      = makeTesseractCorners();
+    obj.projection = std::make_shared<PerspectiveProjection>(3.0);
+    obj.rotators   = { Rotator(0, 1, 0.3), Rotator(0, 1, 0.4), Rotator(2, 3, -1.1), Rotator(1, 3, 2.0) };
+
+    NDShape expected = *obj.shape;
+    for (const Rotator& r : obj.rotators)
+        expected = r.applyRotation(expected);
+    expected = obj.projection->projectShapeToDimension(expected, 3);
+
+    ConvertedData conv = Scene::convertObject(obj, 3);
+    ASSERT_EQ(conv.vertexCount(), 16U);
+    ASSERT_EQ(conv.dimension, 3U);
+    for (std::size_t k = 0; k < conv.vertexCount(); ++k) {
+        std::vector<double> want = expected.getVertex(conv.vertexIds[k]);
+        CoordSpan coords = conv.row(k);
+        for (std::size_t i = 0; i < 3; ++i)
+            EXPECT_NEAR(coords[i], want[i], 1e-12);
+    }
+    EXPECT_EQ(conv.edges.size(), 2U);
+
+    // the source shape is not modified
+    EXPECT_EQ(obj.shape->getVertex(15), (std::vector<double>{0.5, 0.5, 0.5, 0.5}));
+}
+
+/**
+ * @test The matrix is cached until the rotators or the dimension change.
+ */
+TEST(SceneTest, RotationMatrixIsCached) {
+    SceneObject obj;
+    obj.rotators = { Rotator(0, 2, 0.5) };
+
+    auto first = obj.rotationMatrix(4);
+    EXPECT_EQ(obj.rotationMatrix(4), first);
+    EXPECT_NEAR(first->matrix[0 * 4 + 0], std::cos(0.5), 1e-15);
+    EXPECT_NEAR(first->matrix[2 * 4 + 0], std::sin(0.5), 1e-15);
+
+    obj.rotators[0].setAngle(0.25);
+    auto second = obj.rotationMatrix(4);
+    EXPECT_NE(second, first);
+    EXPECT_NE(obj.rotationMatrix(5), second);
+
+    obj.rotators.push_back(Rotator(1, 7, 0.1));
+    EXPECT_THROW(obj.rotationMatrix(4), std::invalid_argument);
+}
+
+/**
+ * @test The composed transform is cached until any of its inputs change.
+ */
+TEST(SceneTest, TransformMatrixIsCached) {
+    SceneObject obj;
+    obj.rotators   = { Rotator(0, 2, 0.5) };
+    obj.projection = std::make_shared<PerspectiveProjection>(3.0);
+    obj.offset     = { 1.0, 2.0, 3.0 };
+
+    auto first = obj.transformMatrix(4, 3);
+    EXPECT_EQ(obj.transformMatrix(4, 3), first);
+    EXPECT_TRUE(first->transform.divide);
+    // w = d + y₃ and the offset is folded in as o·w
+    EXPECT_EQ(first->transform.matrix[4 * 5 + 4], 3.0);
+    EXPECT_EQ(first->transform.matrix[0 * 5 + 4], 1.0 * 3.0);
+
+    obj.offset[0] = 2.0;
+    auto second = obj.transformMatrix(4, 3);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->transform.matrix[0 * 5 + 4], 2.0 * 3.0);
+
+    obj.projection = std::make_shared<OrthographicProjection>();
+    auto third = obj.transformMatrix(4, 3);
+    EXPECT_NE(third, second);
+    EXPECT_FALSE(third->transform.divide);
+    EXPECT_NE(obj.transformMatrix(5, 3), third);
+}
+
+/**
+ * @test After an angle-only edit of a trailing or commuting rotator the kept
+ *       rotated coordinates take one Givens step and convert like the full
+ *       path; other edits drop them, and every kRotationReanchorInterval-th
+ *       step rotates them afresh from the shape.
+ */
+TEST(SceneTest, AngleEditsUpdateRotatedRowsIncrementally) {
+    std::mt19937 rng(7);
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.shape      = makeRandomShape(5, 300, rng);
+    obj.projection = std::make_shared<PerspectiveProjection>(3.0);
+    obj.rotators   = { Rotator(0, 1, 0.3), Rotator(1, 2, -0.7), Rotator(3, 4, 1.1) };
+    obj.scale      = { 2.0, 0.5, 1.0 };
+    obj.offset     = { 0.25, -1.0, 0.0 };
+
+    ConversionOptions full;
+    full.incrementalRotation = false;
+    auto expectFull = [&obj, &full](const ConvertedData& res) {
+        const ConvertedData exact = Scene::convertObject(obj, 3, full);
+        ASSERT_EQ(res.coords.size(), exact.coords.size());
+        for (std::size_t k = 0; k < exact.coords.size(); ++k)
+            EXPECT_NEAR(res.coords[k], exact.coords[k], 1e-12);
+        EXPECT_EQ(res.valid, exact.valid);
+    };
+
+    Scene::convertObject(obj, 3);
+    EXPECT_EQ(obj.rotatedCoords(5), nullptr);
+
+    // the middle rotator commutes with the (3, 4) one after it: coordinates are rotated from the shape
+    obj.rotators[1].setAngle(-0.2);
+    expectFull(Scene::convertObject(obj, 3));
+    auto seeded = obj.rotatedCoords(5);
+    ASSERT_NE(seeded, nullptr);
+    EXPECT_EQ(seeded->deltaSteps, 0U);
+
+    obj.rotators[2].setAngle(0.4);
+    expectFull(Scene::convertObject(obj, 3));
+    EXPECT_EQ(obj.rotatedCoords(5)->deltaSteps, 1U);
+
+    // a single-precision conversion takes the same coordinates
+    ConversionOptions single;
+    single.precision = ConversionPrecision::Single;
+    obj.rotators[2].setAngle(0.5);
+    const ConvertedData f32 = Scene::convertObject(obj, 3, single);
+    EXPECT_EQ(obj.rotatedCoords(5)->deltaSteps, 2U);
+    const ConvertedData f64 = Scene::convertObject(obj, 3, full);
+    for (std::size_t k = 0; k < f64.coords.size(); ++k)
+        EXPECT_NEAR(f32.coordsSingle[k], f64.coords[k], 1e-4);
+
+    // (0, 1) shares an axis with (1, 2): they are dropped
+    obj.rotators[0].setAngle(0.9);
+    expectFull(Scene::convertObject(obj, 3));
+    EXPECT_EQ(obj.rotatedCoords(5), nullptr);
+
+    obj.rotators[2].setAngle(0.2);
+    Scene::convertObject(obj, 3);
+    for (std::size_t step = 1; step < kRotationReanchorInterval; ++step) {
+        obj.rotators[2].setAngle(0.2 + 0.01 * double(step));
+        Scene::convertObject(obj, 3);
+        EXPECT_EQ(obj.rotatedCoords(5)->deltaSteps, step);
+    }
+    obj.rotators[2].setAngle(-1.0);
+    expectFull(Scene::convertObject(obj, 3));
+    EXPECT_EQ(obj.rotatedCoords(5)->deltaSteps, 0U);
+
+    // another shape is rotated afresh
+    obj.shape = makeRandomShape(5, 40, rng);
+    obj.rotators[2].setAngle(-0.5);
+    expectFull(Scene::convertObject(obj, 3));
+    EXPECT_EQ(obj.rotatedCoords(5)->deltaSteps, 0U);
+}
+
+/**
+ * @test The single-matrix conversion matches the staged pipeline up to rounding.
+ */
+TEST(SceneTest, FusedConversionMatchesStaged) {
+    std::mt19937 rng(12345);
+    const std::vector<std::shared_ptr<Projection>> projections = {
+        std::make_shared<PerspectiveProjection>(3.0),
+        std::make_shared<OrthographicProjection>(),
+        std::make_shared<StereographicProjection>(),
+    };
+
+    for (std::size_t dim = 4; dim <= 12; ++dim) {
+        for (const auto& projection : projections) {
+            SceneObject obj;
+            obj.uid        = QUuid::createUuid();
+            obj.shape      = makeRandomShape(dim, 40, rng);
+            obj.projection = projection;
+            obj.rotators   = { Rotator(0, 1, 0.3), Rotator(2, dim - 1, -1.1), Rotator(1, dim - 2, 0.7) };
+            obj.scale      = { 1.5, 0.5, 2.0 };
+            obj.offset     = { 0.25, -1.0, 3.0 };
+
+            ConvertedData fused  = Scene::convertObject(obj, 3);
+            ConvertedData staged = Scene::convertObjectStaged(obj, 3);
+
+            ASSERT_EQ(fused.dimension, staged.dimension);
+            EXPECT_EQ(fused.vertexIds, staged.vertexIds);
+            EXPECT_EQ(fused.edges, staged.edges);
+            ASSERT_EQ(fused.coords.size(), staged.coords.size());
+            for (std::size_t i = 0; i < fused.coords.size(); ++i)
+                // relative: vertices close to the pole are ill-conditioned in both paths
+                EXPECT_NEAR(fused.coords[i], staged.coords[i],
+                            1e-10 * std::max(1.0, std::fabs(staged.coords[i])))
+                    << "dim " << dim << ", value " << i;
+        }
+    }
+}
+
+/**
+ * @test The fused transform only checks the combined denominator: a vertex
+ *       on the pole of an intermediate cascade step stays valid and finite,
+ *       while projecting one dimension at a time rejects it.
+ */
+TEST(SceneTest, FusedAcceptsIntermediatePole) {
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.shape      = std::make_shared<NDShape>(5);
+    obj.projection = std::make_shared<PerspectiveProjection>(1.0);
+    // the 5 -> 4 step divides by x4 + d = 0, the combined w = d + x3 + x4 is 2
+    std::size_t v = obj.shape->addVertex({ 0.1, 0.2, 0.3, 2.0, -1.0 });
+
+    ConvertedData fused = Scene::convertObject(obj, 3);
+    EXPECT_EQ(fused.invalidCount, 0U);
+    ASSERT_TRUE(fused.isValid(fused.rowOf(v)));
+    EXPECT_NEAR(fused.row(fused.rowOf(v))[0], 0.05, 1e-15);
+    EXPECT_NEAR(fused.row(fused.rowOf(v))[1], 0.1, 1e-15);
+    EXPECT_NEAR(fused.row(fused.rowOf(v))[2], 0.15, 1e-15);
+
+    EXPECT_NO_THROW(Scene::convertObjectStaged(obj, 3));
+    EXPECT_THROW(obj.projection->projectShape(*obj.shape), std::runtime_error);
+}
+
+/**
+ * @test Unchanged objects are served from the conversion cache; any field
+ *       change or a new scene dimension converts again.
+ */
+TEST(SceneTest, ConversionCacheFollowsVersions) {
+    Scene scene;
+    QUuid uid = scene.addObject(QUuid::createUuid(), 1, "tesseract", makeTesseractCorners(),
+                                std::make_shared<PerspectiveProjection>(3.0),
+                                { Rotator(0, 3, 0.5) }, { 1, 1, 1 }, { 0, 0, 0 });
+
+    auto first = scene.convertObject(uid);
+    EXPECT_EQ(scene.convertObject(uid), first);
+    EXPECT_EQ(scene.conversionCacheStats().hits, 1U);
+    EXPECT_EQ(scene.conversionCacheStats().misses, 1U);
+
+    auto obj = scene.getObject(uid).lock();
+    scene.setObject(uid, "renamed", obj->shape, obj->projection, obj->rotators, obj->scale, obj->offset);
+    EXPECT_EQ(scene.convertObject(uid), first);   // only the name changed
+
+    scene.setObject(uid, "renamed", obj->shape, obj->projection, obj->rotators, obj->scale, { 1, 0, 0 });
+    EXPECT_EQ(obj->versions.offset, 1U);
+    auto moved = scene.convertObject(uid);
+    EXPECT_NE(moved, first);
+    EXPECT_EQ(moved->row(0)[0], first->row(0)[0] + 1.0);
+
+    scene.setSceneDimension(4);
+    EXPECT_NE(scene.convertObject(uid), moved);
+    EXPECT_EQ(scene.conversionCacheStats().hits, 2U);
+    EXPECT_EQ(scene.conversionCacheStats().misses, 3U);
+
+    scene.resetConversionCacheStats();
+    EXPECT_EQ(scene.conversionCacheStats().hits + scene.conversionCacheStats().misses, 0U);
+}
+
+/**
+ * @test Cloned but unedited shapes and projections, as every UI edit
+ *       passes them, keep their versions and the cached conversion.
+ */
+TEST(SceneTest, ClonedFieldsKeepVersions) {
+    Scene scene;
+    QUuid uid = scene.addObject(QUuid::createUuid(), 1, "tesseract", makeTesseractCorners(),
+                                std::make_shared<PerspectiveProjection>(3.0),
+                                { Rotator(0, 3, 0.5) }, { 1, 1, 1 }, { 0, 0, 0 });
+    auto obj   = scene.getObject(uid).lock();
+    auto first = scene.convertObject(uid);
+
+    SceneObject upd = obj->clone();
+    upd.name = "renamed";
+    scene.setObject(uid, upd.name, upd.shape, upd.projection, upd.rotators, upd.scale, upd.offset);
+    EXPECT_EQ(scene.convertObject(uid), first);
+
+    upd = obj->clone();
+    upd.rotators = { Rotator(0, 3, 0.7) };
+    scene.setObject(uid, upd.name, upd.shape, upd.projection, upd.rotators, upd.scale, upd.offset);
+    EXPECT_EQ(obj->versions.shape, 0U);
+    EXPECT_EQ(obj->versions.projection, 0U);
+    EXPECT_EQ(obj->versions.rotators, 1U);
+
+    upd = obj->clone();
+    upd.shape->addVertex({ 0, 0, 0, 0 });
+    upd.projection = std::make_shared<PerspectiveProjection>(4.0);
+    scene.setObject(uid, upd.name, upd.shape, upd.projection, upd.rotators, upd.scale, upd.offset);
+    EXPECT_EQ(obj->versions.shape, 1U);
+    EXPECT_EQ(obj->versions.projection, 1U);
+}
+
+/**
+ * @test Parallel conversion of many objects keeps object order and fills the cache.
+ */
+TEST(SceneTest, ConvertAllObjectsInParallel) {
+    std::mt19937 rng(7);
+    Scene scene;
+    std::vector<QUuid> uids;
+    for (std::size_t k = 0; k < 12; ++k) {
+        const std::size_t dim = 4 + k % 5;
+        uids.push_back(scene.addObject(QUuid::createUuid(), int(k), "obj", makeRandomShape(dim, 20 + 150 * (k % 4), rng),
+                                       std::make_shared<PerspectiveProjection>(3.0),
+                                       { Rotator(0, dim - 1, 0.1 * double(k)) }, {}, {}));
+    }
+
+    auto all = scene.convertAllObjects();
+    ASSERT_EQ(all.size(), uids.size());
+    for (std::size_t k = 0; k < uids.size(); ++k) {
+        EXPECT_EQ(all[k]->objectUid, uids[k]);
+        ConvertedData serial = Scene::convertObject(*scene.getObject(uids[k]).lock(), 3);
+        EXPECT_EQ(all[k]->coords, serial.coords);
+        EXPECT_EQ(scene.convertObject(uids[k]), all[k]);
+    }
+    EXPECT_EQ(scene.conversionCacheStats().misses, uids.size());
+
+    auto again = scene.convertAllObjects();
+    EXPECT_EQ(again, all);
+    EXPECT_EQ(scene.conversionCacheStats().misses, uids.size());
+
+    // an error in one object surfaces in the caller
+    auto bad = scene.getObject(uids[5]).lock();
+    scene.setObject(uids[5], bad->name, bad->shape, nullptr, bad->rotators, bad->scale, bad->offset);
+    EXPECT_THROW(scene.convertAllObjects(), std::invalid_argument);
+}
+
+/**
+ * @test Splitting one large object across threads gives the serial result.
+ */
+TEST(SceneTest, IntraObjectParallelMatchesSerial) {
+    std::mt19937 rng(99);
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.shape      = makeRandomShape(8, 5003, rng);
+    obj.projection = std::make_shared<StereographicProjection>();
+    obj.rotators   = { Rotator(0, 7, 0.4), Rotator(2, 5, -0.9) };
+    obj.scale      = { 2.0, 2.0, 2.0 };
+
+    ConversionOptions serial;
+    serial.parallel = false;
+    ConversionOptions chunked;
+    chunked.minParallelVertices = 0;
+    chunked.grainSize           = 97;
+
+    ConvertedData a = Scene::convertObject(obj, 3, serial);
+    ConvertedData b = Scene::convertObject(obj, 3, chunked);
+    EXPECT_EQ(a.vertexIds, b.vertexIds);
+    EXPECT_EQ(a.coords, b.coords);
+    EXPECT_EQ(a.edges, b.edges);
+}
+
+/**
+ * @test A vertex at the projection pole is masked out instead of failing the conversion.
+ */
+TEST(SceneTest, InvalidVerticesAreMasked) {
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.name       = "pole";
+    obj.shape      = std::make_shared<NDShape>(4);
+    obj.projection = std::make_shared<StereographicProjection>();
+    std::size_t a = obj.shape->addVertex({ 0.1, 0.2, 0.3, 0.0 });
+    std::size_t p = obj.shape->addVertex({ 0.0, 0.0, 0.0, 1.0 });   // the pole
+    std::size_t b = obj.shape->addVertex({ 0.3, 0.2, 0.1, 0.5 });
+    obj.shape->addEdge(a, p);
+    obj.shape->addEdge(a, b);
+    obj.shape->addEdge(p, b);
+
+    ConvertedData conv;
+    ASSERT_NO_THROW(conv = Scene::convertObject(obj, 3));
+    EXPECT_EQ(conv.invalidCount, 1U);
+    EXPECT_TRUE(conv.isValid(conv.rowOf(a)));
+    EXPECT_FALSE(conv.isValid(conv.rowOf(p)));
+    EXPECT_TRUE(conv.isValid(conv.rowOf(b)));
+    ASSERT_EQ(conv.edges.size(), 1U);
+    EXPECT_EQ(conv.edges[0], std::make_pair(a, b));
+    EXPECT_NEAR(conv.row(conv.rowOf(b))[0], 0.6, 1e-12);
+
+    EXPECT_THROW(Scene::convertObjectStaged(obj, 3), std::runtime_error);
+}
+
+/**
+ * @test Positions are narrowed to float triples at the requested stride,
+ *       padding dimensions below three with zeros.
+ */
+TEST(SceneTest, WritesFloat3Positions) {
+    ConvertedData conv;
+    conv.dimension = 4;
+    conv.vertexIds = { 0, 1 };
+    conv.coords    = { 1.0, 2.0, 3.0, 4.0, -0.5, 0.25, 1e-3, 9.0 };
+
+    std::vector<float> packed(6, -1.0f);
+    conv.writeFloat3(packed.data());
+    EXPECT_EQ(packed, (std::vector<float>{ 1.0f, 2.0f, 3.0f, -0.5f, 0.25f, 1e-3f }));
+
+    std::vector<float> strided(10, -1.0f);
+    conv.writeFloat3(strided.data() + 1, 5);
+    EXPECT_EQ(strided, (std::vector<float>{ -1.0f, 1.0f, 2.0f, 3.0f, -1.0f,
+                                            -1.0f, -0.5f, 0.25f, 1e-3f, -1.0f }));
+
+    conv.dimension = 2;
+    conv.coords    = { 1.0, 2.0, 3.0, 4.0 };
+    conv.writeFloat3(packed.data());
+    EXPECT_EQ(packed, (std::vector<float>{ 1.0f, 2.0f, 0.0f, 3.0f, 4.0f, 0.0f }));
+}
+
+/**
+ * @test Converting straight into a strided buffer writes what a single
+ *       precision conversion narrowed by writeFloat3() would, on the full,
+ *       incremental, parallel and padded paths, and leaves the gaps alone.
+ */
+TEST(SceneTest, ConvertsStraightIntoPositions) {
+    std::mt19937 rng(99);
+    SceneObject obj;
+    obj.uid        = QUuid::createUuid();
+    obj.shape      = makeRandomShape(5, 300, rng);
+    obj.projection = std::make_shared<PerspectiveProjection>(3.0);
+    obj.rotators   = { Rotator(0, 4, 0.4), Rotator(1, 3, -0.2) };
+    obj.scale      = { 1.5, 0.5, 2.0 };
+    obj.offset     = { 0.25, -1.0, 3.0 };
+
+    ConversionOptions single;
+    single.precision           = ConversionPrecision::Single;
+    single.minParallelVertices = 64;
+    single.grainSize           = 50;
+
+    auto expectSame = [&obj](const ConversionOptions& options) {
+        const ConvertedData expected = Scene::convertObject(obj, 3, options);
+        std::vector<float> want(expected.vertexCount() * 3);
+        expected.writeFloat3(want.data());
+
+        constexpr std::size_t stride = 6;
+        std::vector<float> rows(expected.vertexCount() * stride, -7.0f);
+        const ConvertedData direct = Scene::convertObject(obj, 3, options, rows.data(), stride);
+        EXPECT_TRUE(direct.coords.empty());
+        EXPECT_TRUE(direct.coordsSingle.empty());
+        EXPECT_EQ(direct.vertexIds, expected.vertexIds);
+        EXPECT_EQ(direct.edges, expected.edges);
+        EXPECT_EQ(direct.valid, expected.valid);
+        for (std::size_t k = 0; k < direct.vertexCount(); ++k)
+            for (std::size_t i = 0; i < stride; ++i)
+                EXPECT_EQ(rows[k * stride + i], i < 3 ? want[k * 3 + i] : -7.0f);
+    };
+
+    expectSame(single);                        // full matrix, split across threads
+    obj.rotators[1].setAngle(0.1);
+    expectSame(single);                        // incremental rotation
+    single.parallel = false;
+    expectSame(single);
+
+    obj.shape      = makeRandomShape(2, 10, rng);
+    obj.rotators   = { Rotator(0, 1, 0.3) };
+    obj.projection.reset();
+    expectSame(single);                        // padded with zeros
+
+    float dummy[3];
+    EXPECT_THROW(Scene::convertObject(obj, 3, single, nullptr, 3), std::invalid_argument);
+    EXPECT_THROW(Scene::convertObject(obj, 3, single, dummy, 2), std::invalid_argument);
+}
+
+/**
+ * @test Single precision stays within float rounding of the double path,
+ *       the check reports that bound, and switching precision drops the cache.
+ */
+TEST(SceneTest, SinglePrecisionMatchesDoubleWithinBound) {
+    std::mt19937 rng(99);
+    Scene scene;
+    std::vector<QUuid> uids;
+    for (std::size_t k = 0; k < 6; ++k) {
+        const std::size_t dim = 4 + k;
+        uids.push_back(scene.addObject(QUuid::createUuid(), int(k), "obj", makeRandomShape(dim, 300, rng),
+                                       k % 2 ? std::shared_ptr<Projection>(std::make_shared<OrthographicProjection>())
+                                             : std::make_shared<PerspectiveProjection>(3.0),
+                                       { Rotator(0, dim - 1, 0.4), Rotator(1, 2, -0.9) },
+                                       { 1.5, 0.5, 2.0 }, { 0.25, -1.0, 3.0 }));
+    }
+
+    auto exact = scene.convertAllObjects();
+    ConversionOptions options = scene.conversionOptions();
+    options.precision = ConversionPrecision::Single;
+    scene.setConversionOptions(options);
+    auto single = scene.convertAllObjects();
+    EXPECT_EQ(scene.conversionCacheStats().misses, 2 * uids.size());
+
+    for (std::size_t k = 0; k < uids.size(); ++k) {
+        ASSERT_EQ(single[k]->precision, ConversionPrecision::Single);
+        EXPECT_TRUE(single[k]->coords.empty());
+        ASSERT_EQ(single[k]->coordsSingle.size(), exact[k]->coords.size());
+        for (std::size_t i = 0; i < exact[k]->coords.size(); ++i)
+            EXPECT_NEAR(single[k]->coordsSingle[i], exact[k]->coords[i],
+                        1e-5 * std::max(1.0, std::fabs(exact[k]->coords[i])));
+        EXPECT_EQ(single[k]->rowVector(0).size(), 3U);
+    }
+
+    const PrecisionReport report = scene.checkSinglePrecision();
+    EXPECT_EQ(report.objects, uids.size());
+    EXPECT_EQ(report.vertices, uids.size() * 300);
+    EXPECT_EQ(report.validityMismatches, 0U);
+    EXPECT_GT(report.maxAbsError, 0.0);
+    EXPECT_LT(report.maxRelError, 1e-5);
+    EXPECT_FALSE(report.worstObject.isNull());
+}
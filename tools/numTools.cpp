@@ -11,9 +11,6 @@ bool isInteger(float value) {
 
 std::vector<std::size_t> sortedIds(const NDShape& sh)
 {
-    std::vector<std::size_t> ids;
-    ids.reserve(sh.verticesSize());
-    for(auto&& p:sh.getAllVertices()) ids.push_back(p.first);
-    std::sort(ids.begin(),ids.end());
-    return ids;
+    // NDShape keeps its IDs in ascending order already
+    return sh.vertexIds();
 }
@@ -8,7 +8,9 @@
 #include <QString>
 #include <QUuid>
 #include <memory>
+#include <variant>
 #include "../model/scene.h"
+#include "../model/NDShapeBuilder.h"
 #include "../model/sceneColorificator.h"
 
 /* -------------------------------------------------------------------------
@@ -22,6 +24,12 @@ inline QJsonArray vecToJsonArray(const std::vector<double>& v)
     for (double d : v) arr.append(d);
     return arr;
 }
+inline QJsonArray vecToJsonArray(CoordSpan v)
+{
+    QJsonArray arr;
+    for (double d : v) arr.append(d);
+    return arr;
+}
 inline std::vector<double> jsonArrayToVec(const QJsonArray& arr)
 {
     std::vector<double> v;  v.reserve(arr.size());
@@ -66,7 +74,7 @@ public:
         /* ---------- objects ------------------------------------------ */
         QJsonArray jObjects;
         for (const auto& weakObj : scene.getAllObjects()) {
-            if (auto obj = weakObj.lock()) jObjects.append(sceneObjectToJson(*obj));
+            if (auto obj = weakObj.lock()) jObjects.append(sceneObjectToJson(*obj, false));
         }
         root.insert("objects", jObjects);
 
@@ -115,10 +123,12 @@ public:
     }
 
     /* ===================== single object ============================= */
-    /** Serialise just one SceneObject + its colour */
-    static QJsonObject objectToJson(const SceneObject& obj, const QColor& color = SceneColorificator::defaultColor)
+    /** Serialise just one SceneObject + its colour; with @p compactIds the
+     *  written shape is renumbered densely (NDShape::compact()), the object is not. */
+    static QJsonObject objectToJson(const SceneObject& obj, const QColor& color = SceneColorificator::defaultColor,
+                                    bool compactIds = false)
     {
-        QJsonObject j = sceneObjectToJson(obj);
+        QJsonObject j = sceneObjectToJson(obj, compactIds);
         if (color != SceneColorificator::defaultColor)
             j.insert("color", detail::colorToString(color));
         return j;
@@ -141,13 +151,13 @@ public:
     }
 
 private: /* ----------- per‑type helpers ---------------------------------- */
-    static QJsonObject sceneObjectToJson(const SceneObject& obj)
+    static QJsonObject sceneObjectToJson(const SceneObject& obj, bool compactIds)
     {
         QJsonObject jObj;
         jObj.insert("uid",       detail::uidToString(obj.uid));
         jObj.insert("id",        obj.id);
         jObj.insert("name",      obj.name);
-        jObj.insert("shape",     shapeToJson(*obj.shape));
+        jObj.insert("shape",     compactIds ? compactShapeToJson(*obj.shape) : shapeToJson(*obj.shape));
 
         // projection (type + params) ----------------------------------
         if (obj.projection) jObj.insert("projection", projectionToJson(obj.projection.get()));
@@ -193,7 +203,7 @@ private: /* ----------- per‑type helpers ---------------------------------- */
 
         // vertices
         QJsonArray jVerts;
-        for (auto [vid, coords] : shape.getAllVertices()) {
+        for (auto [vid, coords] : shape.vertices()) {
             QJsonObject jv;
             jv.insert("id", static_cast<int>(vid));
             jv.insert("coords", detail::vecToJsonArray(coords));
@@ -211,41 +221,44 @@ private: /* ----------- per‑type helpers ---------------------------------- */
         return jShape;
     }
 
-    static NDShape jsonToShape(const QJsonObject& jShape)
+    static QJsonObject compactShapeToJson(NDShape shape)   // copy-on-write: the source is untouched
     {
-        NDShape shape(jShape.value("dim").toInt());
+        shape.compact();
+        return shapeToJson(shape);
+    }
 
-        // vertices (must be read before edges)
+    static NDShape jsonToShape(const QJsonObject& jShape)
+    {
         QJsonArray jVerts = jShape.value("vertices").toArray();
+        QJsonArray jEdges = jShape.value("edges").toArray();
+        NDShapeBuilder builder(jShape.value("dim").toInt(), jVerts.size(), jEdges.size());
+
+        // vertices keep their stored IDs
         for (const auto& jv : jVerts) {
             QJsonObject vv = jv.toObject();
             auto id        = static_cast<std::size_t>(vv.value("id").toInt());
-            auto coords    = detail::jsonArrayToVec(vv.value("coords").toArray());
-            // use private API via cloning trick: add temp id order preserved
-            while (shape.getAllVertices().size() <= id) shape.addVertex(coords); // ensures sequential
-            shape.setVertexCoords(id, coords);
+            builder.addVertexWithId(id, detail::jsonArrayToVec(vv.value("coords").toArray()));
         }
 
         // edges ------------------------------------------------------
-        QJsonArray jEdges = jShape.value("edges").toArray();
         for (const auto& je : jEdges) {
             QJsonArray pair = je.toArray();
-            shape.addEdge(pair.at(0).toInt(), pair.at(1).toInt());
+            builder.addEdge(pair.at(0).toInt(), pair.at(1).toInt());
         }
-        return shape;
+        return builder.finish();
     }
 
     /* ---- Projection ----------------------------------------------------- */
     static QJsonObject projectionToJson(const Projection* proj)
     {
         QJsonObject j;
-        if (auto pp = dynamic_cast<const PerspectiveProjection*>(proj)) {
-            double dist = const_cast<PerspectiveProjection*>(pp)->getDistance(); // getDistance not const
+        const ProjectionParams params = proj->kernelParams();
+        if (auto pp = std::get_if<PerspectiveParams>(&params)) {
             j.insert("type", "Perspective");
-            j.insert("distance", dist);
-        } else if (dynamic_cast<const OrthographicProjection*>(proj)) {
+            j.insert("distance", pp->distance);
+        } else if (std::holds_alternative<OrthographicParams>(params)) {
             j.insert("type", "Orthographic");
-        } else if (dynamic_cast<const StereographicProjection*>(proj)) {
+        } else if (std::holds_alternative<StereographicParams>(params)) {
             j.insert("type", "Stereographic");
         }
         return j;
@@ -255,11 +268,11 @@ private: /* ----------- per‑type helpers ---------------------------------- */
     {
         const QString type = j.value("type").toString();
         if (type == "Perspective") {
-            return std::make_shared<PerspectiveProjection>( j.value("distance").toDouble() );
+            return makeProjection(PerspectiveParams{ j.value("distance").toDouble() });
         } else if (type == "Orthographic") {
-            return std::make_shared<OrthographicProjection>();
+            return makeProjection(OrthographicParams{});
         } else if (type == "Stereographic") {
-            return std::make_shared<StereographicProjection>();
+            return makeProjection(StereographicParams{});
         }
         return nullptr; // unknown
     }
@@ -114,6 +114,7 @@ NDShapeEditorDialog::NDShapeEditorDialog(const NDShape& startShape,
     makeAction("cut",    tr("Cut"),    QKeySequence::Cut,    &NDShapeEditorDialog::cutVertices);
     makeAction("paste",  tr("Paste"),  QKeySequence::Paste,  &NDShapeEditorDialog::pasteVertices);
     makeAction("delete", tr("Delete"), QKeySequence::Delete, &NDShapeEditorDialog::removeVertices);
+    makeAction("compact", tr("Renumber IDs"), QKeySequence(), &NDShapeEditorDialog::compactVertexIds);
 
     vertVBox->addWidget(vertView_);
 
@@ -198,13 +199,12 @@ void NDShapeEditorDialog::removeVertices()
 
     NDShape before=*shape_;
 
-    QVector<std::size_t> ids;
+    std::vector<std::size_t> ids;
     ids.reserve(sel.size());
     for(const QModelIndex& idx : sel)
-        ids << rowToId_->at(std::size_t(idx.row()));
+        ids.push_back(rowToId_->at(std::size_t(idx.row())));
 
-    std::sort(ids.begin(), ids.end(), std::greater<>());
-    for(auto id : ids) shape_->removeVertex(id);
+    shape_->removeVertices(ids);
 
     NDShape after = *shape_;
     undo_->push(new ShapeCommand(
@@ -212,6 +212,30 @@ void NDShapeEditorDialog::removeVertices()
         [this](){ structuralReload();}));
 }
 
+void NDShapeEditorDialog::compactVertexIds()
+{
+    std::vector<std::size_t> selectedIds;
+    for (const QModelIndex& idx : vertView_->selectionModel()->selectedRows())
+        selectedIds.push_back(rowToId_->at(std::size_t(idx.row())));
+
+    NDShape before = *shape_;
+    const std::vector<std::size_t> remap = shape_->compact();
+    NDShape after  = *shape_;
+
+    undo_->push(new ShapeCommand(
+        shape_, before, after, tr("Renumber vertex IDs"),
+        [this](){ structuralReload();}));
+
+    // IDs are dense now, so the new ID is also the row
+    QItemSelection selection;
+    for (std::size_t oldId : selectedIds) {
+        const int row = int(remap[oldId]);
+        selection.select(vertModel_->index(row, 0),
+                         vertModel_->index(row, vertModel_->columnCount() - 1));
+    }
+    vertView_->selectionModel()->select(selection, QItemSelectionModel::ClearAndSelect);
+}
+
 void NDShapeEditorDialog::copyVertices()
 {
     vertClipboard_.clear();
@@ -232,15 +256,17 @@ void NDShapeEditorDialog::pasteVertices()
 
     NDShape before = *shape_;
 
-    const std::size_t dim = shape_->getDimension();
-    for (const auto& oldCoords : vertClipboard_) {
-        std::vector<double> newCoords(dim, 0.0);
+    const std::size_t dim   = shape_->getDimension();
+    const std::size_t count = std::size_t(vertClipboard_.size());
+    std::vector<double> flat(count * dim, 0.0);
+    for (std::size_t k = 0; k < count; ++k) {
+        const auto& oldCoords = vertClipboard_[int(k)];
         const std::size_t copyCount = std::min<std::size_t>(dim, oldCoords.size());
-        for (std::size_t i = 0; i < copyCount; ++i)
-            newCoords[i] = oldCoords[i];
-        shape_->addVertex(newCoords);
+        std::copy_n(oldCoords.begin(), copyCount, flat.begin() + k * dim);
     }
 
+    shape_->addVertices(flat.data(), count);
+
     NDShape after = *shape_;
     undo_->push(new ShapeCommand(
         shape_, before, after, tr("Paste vertices"),
@@ -275,5 +301,7 @@ void NDShapeEditorDialog::showVertContextMenu(const QPoint& pos)
     menu.addAction(vertActs_["cut"]);
     menu.addAction(vertActs_["paste"]);
     menu.addAction(vertActs_["delete"]);
+    menu.addSeparator();
+    menu.addAction(vertActs_["compact"]);
     menu.exec(vertView_->viewport()->mapToGlobal(pos));
 }
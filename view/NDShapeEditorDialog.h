@@ -34,6 +34,7 @@ private slots:
     void onDimensionChanged(int d);
     void addVertex();
     void removeVertices();
+    void compactVertexIds();
 
     void showVertContextMenu(const QPoint& pos);
     void copyVertices();
@@ -16,6 +16,7 @@
 #include <numeric>
 #include <memory>
 #include <cmath>
+#include "../model/NDShapeBuilder.h"
 
 /* ---------- ctor & UI ---------- */
 AddSceneObjectDialog::AddSceneObjectDialog(QWidget *parent)
@@ -123,20 +124,20 @@ std::shared_ptr<Projection> AddSceneObjectDialog::projection() const
 /* ---------- shape builders ---------- */
 std::shared_ptr<NDShape> AddSceneObjectDialog::buildHypercube(int n) const
 {
-    auto s = std::make_shared<NDShape>(n);
-    std::vector<std::size_t> verts;
     const std::size_t total = 1u << n;
-    for (std::size_t i = 0; i < total; ++i) {
-        std::vector<double> coord(n);
+    NDShapeBuilder builder(n, total, total * n / 2);
+
+    std::vector<double> coords(total * n);
+    for (std::size_t i = 0; i < total; ++i)
         for (int bit = 0; bit < n; ++bit)
-            coord[bit] = (i & (1u << bit)) ? 1.0 : -1.0;
-        verts.push_back(s->addVertex(coord));
-    }
+            coords[i * n + bit] = (i & (1u << bit)) ? 1.0 : -1.0;
+    const std::size_t first = builder.addVertices(coords.data(), total);
+
     for (std::size_t i = 0; i < total; ++i)
         for (int bit = 0; bit < n; ++bit)
             if (i < (i ^ (1u << bit)))
-                s->addEdge(verts[i], verts[i ^ (1u << bit)]);
-    return s;
+                builder.addEdge(first + i, first + (i ^ (1u << bit)));
+    return std::make_shared<NDShape>(builder.finish());
 }
 
 /* ---------- regular simplex -------------- */
@@ -193,7 +194,8 @@ std::shared_ptr<NDShape> AddSceneObjectDialog::buildSimplex(int n) const
     };
 
     /* ========== 3. add rotated vertices (first n coords) to NDShape ======= */
-    auto shape = std::make_shared<NDShape>(static_cast<std::size_t>(n));
+    NDShapeBuilder builder(static_cast<std::size_t>(n), bigN,
+                           static_cast<std::size_t>(bigN) * n / 2);
     std::vector<std::size_t> verts;  verts.reserve(bigN);
 
     for (const Vec& w : raw)
@@ -201,37 +203,37 @@ std::shared_ptr<NDShape> AddSceneObjectDialog::buildSimplex(int n) const
         Vec r = applyHouseholder(w);                  // now lies in x_{n}=0
         r.pop_back();                                 // drop last coord → ℝⁿ
 
-        verts.push_back(shape->addVertex(r));         // store vertex
+        verts.push_back(builder.addVertex(r));        // store vertex
     }
 
     /* ========== 4. connect every pair of vertices (complete graph) ========= */
     for (std::size_t i = 0; i < verts.size(); ++i)
         for (std::size_t j = i + 1; j < verts.size(); ++j)
-            shape->addEdge(verts[i], verts[j]);
+            builder.addEdge(verts[i], verts[j]);
 
-    return shape;
+    return std::make_shared<NDShape>(builder.finish());
 }
 
 /* ---------- cross-polytope ------------- */
 std::shared_ptr<NDShape> AddSceneObjectDialog::buildCrossPolytope(int n) const
 {
-    auto shp = std::make_shared<NDShape>(n);
+    NDShapeBuilder builder(n, 2 * n, 2 * n * (n - 1));
     std::vector<std::size_t> idx;
 
     // vertices ±e_i
     for (int i = 0; i < n; ++i) {
         std::vector<double> v(n, 0.0);
-        v[i] =  1.0; idx.push_back(shp->addVertex(v));
-        v[i] = -1.0; idx.push_back(shp->addVertex(v));
+        v[i] =  1.0; idx.push_back(builder.addVertex(v));
+        v[i] = -1.0; idx.push_back(builder.addVertex(v));
     }
 
     // edges: vertices on different axes
     for (std::size_t a = 0; a < idx.size(); ++a)
         for (std::size_t b = a + 1; b < idx.size(); ++b)
             if (a / 2 != b / 2)
-                shp->addEdge(idx[a], idx[b]);
+                builder.addEdge(idx[a], idx[b]);
 
-    return shp;
+    return std::make_shared<NDShape>(builder.finish());
 }
 
 /* ---------- permutohedron -------------- */
@@ -308,14 +310,16 @@ std::shared_ptr<NDShape> AddSceneObjectDialog::buildPermutohedron(int n) const
     };
 
     /* ---------- 3.  add rotated vertices to NDShape ----------------------- */
-    auto shape = std::make_shared<NDShape>(static_cast<std::size_t>(n));
+    // each vertex has n-1 neighbours (adjacent transpositions)
+    NDShapeBuilder builder(static_cast<std::size_t>(n), raw.size(),
+                           raw.size() * (n - 1) / 2);
     std::unordered_map<std::string, std::size_t> vertexIdOf;   // perm → id
     vertexIdOf.reserve(raw.size());
 
     for (std::size_t k = 0; k < raw.size(); ++k)
     {
         const std::vector<double> coords = applyHouseholder(raw[k]);
-        const std::size_t id = shape->addVertex(coords);
+        const std::size_t id = builder.addVertex(coords);
         vertexIdOf.emplace(encode(permutations[k]), id);
     }
 
@@ -335,12 +339,12 @@ std::shared_ptr<NDShape> AddSceneObjectDialog::buildPermutohedron(int n) const
                 if (auto it = vertexIdOf.find(encode(neigh)); it != vertexIdOf.end())
                 {
                     const std::size_t idB = it->second;
-                    if (idA < idB) shape->addEdge(idA, idB); // keep “add once” rule
+                    if (idA < idB) builder.addEdge(idA, idB); // keep “add once” rule
                 }
             }
     }
 
-    return shape;
+    return std::make_shared<NDShape>(builder.finish());
 }
 
 
@@ -376,8 +380,9 @@ void AddSceneObjectDialog::accept()
         nameEdit_->setText(defaultName());
 
     SceneObject probe = makeSceneObject(0);
+    std::size_t invalid = 0;
     try {
-        Scene::convertObject(probe, 3);
+        invalid = Scene::convertObject(probe, 3).invalidCount;
     } catch (const std::exception& ex) {
         QMessageBox::warning(this, tr("Cannot add object"),
                              tr("This object cannot be projected to 3-D:\n%1")
@@ -385,5 +390,19 @@ void AddSceneObjectDialog::accept()
         return;
     }
 
+    // vertices on the projection's singularity are dropped from the view
+    if (invalid > 0) {
+        auto btn = QMessageBox::warning(
+            this,
+            tr("Cannot project all vertices"),
+            tr("%n vertex(es) cannot be projected to 3-D and will not be drawn, "
+               "along with their edges.\nAdd the object anyway?", nullptr, int(invalid)),
+            QMessageBox::Ok | QMessageBox::Cancel,
+            QMessageBox::Cancel
+            );
+        if (btn == QMessageBox::Cancel)
+            return;
+    }
+
     QDialog::accept();
 }
@@ -0,0 +1,95 @@
+#include "shapeDeltaCommand.h"
+
+namespace {
+constexpr int kShapeDeltaId = 0x5d;
+}
+
+ShapeDeltaCommand::ShapeDeltaCommand(std::shared_ptr<NDShape> shape,
+                                     const QString&           text,
+                                     std::function<void()>    reload)
+    : shape_(std::move(shape)), reload_(std::move(reload))
+{
+    setText(text);
+}
+
+ShapeDeltaCommand* ShapeDeltaCommand::editVertex(std::shared_ptr<NDShape> shape,
+                                                 std::size_t              vertexId,
+                                                 std::vector<double>      after,
+                                                 const QString&           text,
+                                                 std::function<void()>    reload)
+{
+    auto* cmd = new ShapeDeltaCommand(shape, text, std::move(reload));
+    cmd->vertices_.push_back({ vertexId, shape->getVertex(vertexId), std::move(after) });
+    return cmd;
+}
+
+ShapeDeltaCommand* ShapeDeltaCommand::setEdge(std::shared_ptr<NDShape> shape,
+                                              std::size_t a, std::size_t b, bool add,
+                                              const QString&           text,
+                                              std::function<void()>    reload)
+{
+    auto* cmd = new ShapeDeltaCommand(std::move(shape), text, std::move(reload));
+    (add ? cmd->addedEdges_ : cmd->removedEdges_).emplace_back(a, b);
+    return cmd;
+}
+
+void ShapeDeltaCommand::undo() {
+    for (const auto& [a, b] : addedEdges_)   shape_->removeEdge(a, b);
+    for (const auto& [a, b] : removedEdges_) shape_->addEdge(a, b);
+    for (const auto& v : vertices_)          shape_->setVertexCoords(v.id, v.before);
+    reload_();
+}
+
+void ShapeDeltaCommand::redo() {
+    for (const auto& v : vertices_)          shape_->setVertexCoords(v.id, v.after);
+    for (const auto& [a, b] : removedEdges_) shape_->removeEdge(a, b);
+    for (const auto& [a, b] : addedEdges_)   shape_->addEdge(a, b);
+    reload_();
+}
+
+int ShapeDeltaCommand::id() const {
+    return kShapeDeltaId;
+}
+
+bool ShapeDeltaCommand::mergeWith(const QUndoCommand* other) {
+    auto* next = static_cast<const ShapeDeltaCommand*>(other);
+    if (next->shape_ != shape_) return false;
+
+    // repeated edits of one vertex: keep the first "before", take the last "after"
+    if (vertices_.size() == 1 && next->vertices_.size() == 1
+        && addedEdges_.empty() && removedEdges_.empty()
+        && next->addedEdges_.empty() && next->removedEdges_.empty()
+        && vertices_.front().id == next->vertices_.front().id)
+    {
+        vertices_.front().after = next->vertices_.front().after;
+        setObsolete(vertices_.front().after == vertices_.front().before);
+        return true;
+    }
+
+    // toggling an edge back cancels both commands
+    auto sameEdge = [](const Edge& x, const Edge& y) {
+        return (x.first == y.first && x.second == y.second)
+            || (x.first == y.second && x.second == y.first);
+    };
+    const bool singleEdgeEach =
+        vertices_.empty() && next->vertices_.empty()
+        && addedEdges_.size() + removedEdges_.size() == 1
+        && next->addedEdges_.size() + next->removedEdges_.size() == 1;
+    if (singleEdgeEach) {
+        if (addedEdges_.size() == 1 && next->removedEdges_.size() == 1
+            && sameEdge(addedEdges_.front(), next->removedEdges_.front()))
+        {
+            addedEdges_.clear();
+            setObsolete(true);
+            return true;
+        }
+        if (removedEdges_.size() == 1 && next->addedEdges_.size() == 1
+            && sameEdge(removedEdges_.front(), next->addedEdges_.front()))
+        {
+            removedEdges_.clear();
+            setObsolete(true);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,60 @@
+#ifndef SHAPE_DELTA_COMMAND_H
+#define SHAPE_DELTA_COMMAND_H
+
+#include <QUndoCommand>
+#include "../../model/NDShape.h"
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+
+/**
+ * @brief Undo command that records only what an edit changed in an NDShape.
+ *
+ * Stores the old/new coordinates of the edited vertices and the added or
+ * removed edges, so its memory is proportional to the change rather than
+ * to the shape. The shape is modified in redo(), which QUndoStack::push()
+ * calls immediately.
+ *
+ * Consecutive edits of the same vertex, or repeated toggles of the same
+ * edge, are merged into one command; a merge that cancels out marks the
+ * command obsolete so the stack drops it.
+ */
+class ShapeDeltaCommand final : public QUndoCommand {
+public:
+    using Edge = std::pair<std::size_t, std::size_t>;
+
+    /// Sets the coordinates of vertex @p vertexId to @p after.
+    static ShapeDeltaCommand* editVertex(std::shared_ptr<NDShape> shape,
+                                         std::size_t              vertexId,
+                                         std::vector<double>      after,
+                                         const QString&           text,
+                                         std::function<void()>    reload);
+
+    /// Adds the edge (a, b) if @p add is true, removes it otherwise.
+    static ShapeDeltaCommand* setEdge(std::shared_ptr<NDShape> shape,
+                                      std::size_t a, std::size_t b, bool add,
+                                      const QString&           text,
+                                      std::function<void()>    reload);
+
+    void undo() override;
+    void redo() override;
+    int  id() const override;
+    bool mergeWith(const QUndoCommand* other) override;
+
+private:
+    struct VertexChange {
+        std::size_t         id;
+        std::vector<double> before, after;
+    };
+
+    ShapeDeltaCommand(std::shared_ptr<NDShape> shape, const QString& text,
+                      std::function<void()> reload);
+
+    std::shared_ptr<NDShape> shape_;
+    std::vector<VertexChange> vertices_;
+    std::vector<Edge>         addedEdges_, removedEdges_;
+    std::function<void()>     reload_;
+};
+
+#endif // SHAPE_DELTA_COMMAND_H
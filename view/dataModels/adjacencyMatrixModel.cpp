@@ -2,7 +2,7 @@
 #include <QBrush>
 #include <QUndoStack>
 #include "../../tools/numTools.h"
-#include "../commands/shapeCommand.h"
+#include "../commands/shapeDeltaCommand.h"
 
 /*──────────── ctor ───────────────────────────────────────────────*/
 AdjacencyMatrixModel::AdjacencyMatrixModel(std::shared_ptr<NDShape> s,
@@ -37,21 +37,9 @@ Qt::ItemFlags AdjacencyMatrixModel::flags(const QModelIndex& i) const
 }
 
 // ────── fast edge check ──────────────────────────────────────────────────────
-void AdjacencyMatrixModel::buildEdgeLookup()
-{
-    edges_.clear();
-    edges_.reserve(shape_->edgesSize() * 2);
-    for (auto&& e : shape_->getEdges()) {
-        auto p = std::minmax(e.first, e.second);
-        edges_.emplace(p.first, p.second);
-    }
-}
-
 bool AdjacencyMatrixModel::edgeExists(std::size_t a, std::size_t b) const
 {
-    if (a == b) return false;
-    auto p = std::minmax(a, b);
-    return edges_.find({p.first, p.second}) != edges_.end();
+    return shape_->hasEdge(a, b);
 }
 
 QVariant AdjacencyMatrixModel::data(const QModelIndex& i, int role) const
@@ -72,13 +60,9 @@ void AdjacencyMatrixModel::toggleEdge(int row,int col)
     std::size_t a = rowToId_->at(row), b = rowToId_->at(col);
     bool nowOn = !edgeExists(a,b);
 
-    NDShape before=*shape_;
-    nowOn ? shape_->addEdge(a,b) : shape_->removeEdge(a,b);
-    NDShape after=*shape_;
-
-    undo_->push(new ShapeCommand(shape_,before,after,
-                                 tr("Toggle edge"),
-                                 [this]{ structuralReload_(); }));
+    undo_->push(ShapeDeltaCommand::setEdge(shape_, a, b, nowOn,
+                                           tr("Toggle edge"),
+                                           [this]{ structuralReload_(); }));
 
     // QModelIndex tl=index(row,col), br=index(col,row);
     // emit dataChanged(tl, tl, {Qt::BackgroundRole});
@@ -101,6 +85,5 @@ void AdjacencyMatrixModel::reload()
 {
     beginResetModel();
     *rowToId_ = sortedIds(*shape_);
-    buildEdgeLookup();
     endResetModel();
 }
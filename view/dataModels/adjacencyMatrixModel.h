@@ -5,7 +5,6 @@
 #include <memory>
 #include "../../model/NDShape.h"
 #include <QColor>
-#include <unordered_set>
 #include <functional>
 #include <utility>
 #include <cstddef>
@@ -37,26 +36,8 @@ public:
     void reload();
 
 private:
-    struct PairHash {
-        size_t operator()(const std::pair<std::size_t,std::size_t>& p) const noexcept {
-            std::size_t seed = 0;
-            seed ^= std::hash<std::size_t>{}(p.first)
-                    + 0x9e3779b97f4a7c15ULL
-                    + (seed << 6)
-                    + (seed >> 2);
-            seed ^= std::hash<std::size_t>{}(p.second)
-                    + 0x9e3779b97f4a7c15ULL
-                    + (seed << 6)
-                    + (seed >> 2);
-            return seed;
-        }
-    };
-
     bool edgeExists(std::size_t a, std::size_t b) const;
 
-    void buildEdgeLookup();
-    void rebuildCache();
-
     // ────── state ────────────────────────────────────────────────────────
     const QColor colorUndefined_ = Qt::black;
     const QColor colorTrue_      = Qt::darkGreen;
@@ -68,9 +49,6 @@ private:
     // keeps mapping for full graph
     std::shared_ptr<std::vector<std::size_t>> rowToId_;
 
-    // fast O(1) edge lookup
-    std::unordered_set<std::pair<std::size_t,std::size_t>, PairHash> edges_;
-
     std::function<void()> structuralReload_;
 };
 
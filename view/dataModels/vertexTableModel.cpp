@@ -2,7 +2,7 @@
 #include <QUndoStack>
 #include <cmath>
 #include "../../tools/numTools.h"
-#include "../commands/shapeCommand.h"
+#include "../commands/shapeDeltaCommand.h"
 
 /*──────────── ctor ───────────────────────────────────────────────*/
 VertexTableModel::VertexTableModel(std::shared_ptr<NDShape> s,
@@ -37,9 +37,10 @@ QVariant VertexTableModel::headerData(int sec, Qt::Orientation o, int role) cons
 QVariant VertexTableModel::data(const QModelIndex& idx, int role) const
 {
     if (!idx.isValid()) return {};
-    const auto& c = shape_->getVertex(rowToId_->at(idx.row()));
-    if (role == Qt::DisplayRole || role == Qt::EditRole)
+    if (role == Qt::DisplayRole || role == Qt::EditRole) {
+        CoordSpan c = shape_->vertexCoords(rowToId_->at(idx.row()));
         return QString::number(c[idx.column()], 'g', 6);
+    }
     return {};
 }
 
@@ -59,17 +60,14 @@ bool VertexTableModel::setData(const QModelIndex& idx,
     double val = v.toDouble(&ok);
     if(!ok) return false;
 
-    auto coords = shape_->getVertex(rowToId_->at(idx.row()));
+    const std::size_t id = rowToId_->at(idx.row());
+    auto coords = shape_->getVertex(id);
     if (std::abs(coords[idx.column()] - val) < 1e-9) return true;
 
-    NDShape before = *shape_;
     coords[idx.column()] = val;
-    shape_->setVertexCoords(rowToId_->at(idx.row()), coords);
-    NDShape after = *shape_;
-
-    undo_->push(new ShapeCommand(shape_, before, after,
-                                 tr("Edit vertex"),
-                                 [this]{ structuralReload_(); }));
+    undo_->push(ShapeDeltaCommand::editVertex(shape_, id, std::move(coords),
+                                              tr("Edit vertex"),
+                                              [this]{ structuralReload_(); }));
 
     // emit dataChanged(idx, idx, {Qt::DisplayRole, Qt::EditRole});
     return true;
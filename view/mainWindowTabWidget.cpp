@@ -344,6 +344,35 @@ void MainWindowTabWidget::onCurrentRowChanged(const QModelIndex &current,
     });
 }
 
+bool MainWindowTabWidget::compactVertexIds()
+{
+    if (!model_) return false;
+
+    bool changed = false;
+    for (int row = 0; row < model_->rowCount(); ++row) {
+        std::shared_ptr<SceneObject> obj = model_->getObjectByRow(row);
+        if (!obj || !obj->shape) continue;
+        const std::vector<std::size_t>& ids = obj->shape->vertexIds();
+        if (ids.empty() || ids.back() + 1 == ids.size()) continue;   // already dense
+
+        SceneObject upd = obj->clone();
+        upd.shape->compact();
+        if (!changed) undoStack_->beginMacro(tr("Renumber vertex IDs"));
+        changed = true;
+        undoStack_->push(new ChangeSceneObjectCommand(
+            model_, row, upd, sceneColorificator_->getColorForObject(obj->uid),
+            [this]{
+                sceneRenderer_->updateAll();
+                markDirty();
+            },
+            [this]{
+                editor_->rebuildUiFromCurrent();
+            }));
+    }
+    if (changed) undoStack_->endMacro();
+    return changed;
+}
+
 void MainWindowTabWidget::selectLastObject()
 {
     int row = model_->rowCount() - 1;
@@ -393,7 +422,8 @@ void MainWindowTabWidget::exportSelectedObject()
         }
 
         QColor col = sceneColorificator_->getColorForObject(obj->uid);
-        QJsonDocument doc(SceneSerializer::objectToJson(*obj, col));
+        QJsonDocument doc(SceneSerializer::objectToJson(*obj, col,
+                                                        PresenterMainTab::compactIdsOnSave));
         f.write(doc.toJson(QJsonDocument::Indented));
         f.close();
     }
@@ -38,6 +38,13 @@ public:
     CameraController *cameraController() const;
     SceneInputHandler *inputHandler() const;
 
+    /**
+     * @brief Renumbers the vertices of every shape with gaps in its IDs
+     *        densely (NDShape::compact()), as one undoable step.
+     * @return Whether any shape was renumbered.
+     */
+    bool compactVertexIds();
+
 protected:
     bool event(QEvent* ev) override;
     void keyPressEvent(QKeyEvent* ev) override;
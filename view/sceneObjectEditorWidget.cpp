@@ -21,6 +21,7 @@
 #include <QShortcut>
 #include <QMenu>
 #include <QScrollBar>
+#include <variant>
 
 /* ---------- helpers ---------- */
 static QString css(const QColor& c){ return QString("background:%1").arg(c.name()); }
@@ -158,17 +159,18 @@ void SceneObjectEditorWidget::rebuildUiFromCurrent()
     perspDist_->blockSignals(true);
     projCombo_->blockSignals(true);
 
+    const ProjectionParams params = cur_->projection ? cur_->projection->kernelParams()
+                                                     : ProjectionParams{};
     if(!cur_->projection){
         projCombo_->setCurrentIndex(0);
         perspDist_->setVisible(false);
         distanceLabel_->setVisible(false);
-    }else if(dynamic_cast<PerspectiveProjection*>(cur_->projection.get())){
+    }else if(auto *pp = std::get_if<PerspectiveParams>(&params)){
         projCombo_->setCurrentIndex(1);
         perspDist_->setVisible(true);
         distanceLabel_->setVisible(true);
-        auto *pp = static_cast<PerspectiveProjection*>(cur_->projection.get());
-        perspDist_->setValue(pp->getDistance());
-    }else if(dynamic_cast<OrthographicProjection*>(cur_->projection.get())){
+        perspDist_->setValue(pp->distance);
+    }else if(std::holds_alternative<OrthographicParams>(params)){
         projCombo_->setCurrentIndex(2);
         perspDist_->setVisible(false);
         distanceLabel_->setVisible(false);
@@ -212,14 +214,31 @@ void SceneObjectEditorWidget::commit(bool geometryChanged,
     obj.scale  = scaleBox_->value();
     obj.offset = offsetBox_->value();
 
+    std::size_t invalid = 0;
     try{
-        Scene::convertObject(obj, 3);
+        invalid = Scene::convertObject(obj, 3).invalidCount;
     } catch (const std::exception &ex){
         QString error = QString::fromUtf8(ex.what());
         QMessageBox::warning(this, tr("Invalid scene object"), error);
         rebuildUiFromCurrent();
         return;
     }
+
+    // vertices on the projection's singularity are dropped from the view
+    if (invalid > 0) {
+        auto btn = QMessageBox::warning(
+            this,
+            tr("Cannot project all vertices"),
+            tr("%n vertex(es) cannot be projected to 3-D and will not be drawn, "
+               "along with their edges.\nApply the change anyway?", nullptr, int(invalid)),
+            QMessageBox::Ok | QMessageBox::Cancel,
+            QMessageBox::Cancel
+            );
+        if (btn == QMessageBox::Cancel) {
+            rebuildUiFromCurrent();
+            return;
+        }
+    }
     emit objectEdited(obj, color, geometryChanged);
 }
 
@@ -239,13 +258,15 @@ void SceneObjectEditorWidget::projectionChanged()
     int newIndex    = projCombo_->currentIndex();
     double newDist  = perspDist_->value();
     bool sameProj = false;
+    const ProjectionParams params = cur_->projection ? cur_->projection->kernelParams()
+                                                     : ProjectionParams{};
     if (!cur_->projection && newIndex == 0) {
         sameProj = true;
-    } else if (auto *pp = dynamic_cast<PerspectiveProjection*>(cur_->projection.get())) {
-        sameProj = (newIndex == 1 && pp->getDistance() == newDist);
-    } else if (dynamic_cast<OrthographicProjection*>(cur_->projection.get())) {
+    } else if (auto *pp = std::get_if<PerspectiveParams>(&params)) {
+        sameProj = (newIndex == 1 && pp->distance == newDist);
+    } else if (std::holds_alternative<OrthographicParams>(params)) {
         sameProj = (newIndex == 2);
-    } else if (dynamic_cast<StereographicProjection*>(cur_->projection.get())) {
+    } else if (std::holds_alternative<StereographicParams>(params)) {
         sameProj = (newIndex == 3);
     }
     if (sameProj)